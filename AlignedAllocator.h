@@ -0,0 +1,56 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : AlignedAllocator.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+using namespace std;
+
+
+/**
+	@brief Allocator of storage aligned to Alignment bytes (a power of two, at least the alignment
+	of T), so that a vector using it starts on a cache line or on a SIMD register boundary.
+*/
+template<class T, size_t Alignment = 64>
+class AlignedAllocator
+{
+public:
+    typedef T value_type;
+
+    template<class U> struct rebind { typedef AlignedAllocator<U, Alignment> other; };
+
+    AlignedAllocator() {}
+    template<class U> AlignedAllocator(const AlignedAllocator<U, Alignment> &) {}
+
+    ///The block is over-allocated, and the address returned by operator new is kept just before
+    ///the aligned storage
+    T *allocate(size_t n)
+    {
+        char *block = (char*)::operator new(n * sizeof(T) + Alignment + sizeof(void*));
+        size_t aligned = ((size_t)(block + sizeof(void*)) + Alignment - 1) & ~(Alignment - 1);
+        ((void**)aligned)[-1] = block;
+        return (T*)aligned;
+    }
+
+    void deallocate(T *p, size_t)
+    {
+        if (p)
+            ::operator delete(((void**)p)[-1]);
+    }
+
+    template<class U> bool operator==(const AlignedAllocator<U, Alignment> &) const { return true; }
+    template<class U> bool operator!=(const AlignedAllocator<U, Alignment> &) const { return false; }
+};
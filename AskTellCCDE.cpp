@@ -0,0 +1,305 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : AskTellCCDE.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "AskTellCCDE.h"
+#include <climits>
+
+using namespace std;
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+EvaluationChannel::EvaluationChannel(unsigned _dimension) : dimension(_dimension), finished(false), closed(false)
+{
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+bool EvaluationChannel::submit(const double *X, size_t n, double *out)
+{
+    Request r = { X, n, out, false };
+
+    unique_lock<mutex> lock(channelMutex);
+    if (!closed)
+    {
+        pending.push_back(&r);
+        requestAvailable.notify_all();
+        resultAvailable.wait(lock, [this, &r] { return r.done || closed; });
+    }
+
+    if (!r.done)
+        for (size_t i = 0; i < n; ++i)
+            out[i] = std::numeric_limits<double>::infinity();
+
+    return r.done;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+unsigned EvaluationChannel::ask(vector<double> &X)
+{
+    unique_lock<mutex> lock(channelMutex);
+
+    if (!asked.empty())
+    {
+        cerr << "ask() called before tell() in EvaluationChannel" << endl;
+        exit(1);
+    }
+
+    requestAvailable.wait(lock, [this] { return !pending.empty() || finished || closed; });
+
+    X.clear();
+    if (closed)
+        return 0;
+
+    //gather everything submitted so far, e.g. by several optimizers running in parallel
+    asked.swap(pending);
+
+    unsigned n = 0;
+    for (unsigned i = 0; i < asked.size(); ++i)
+    {
+        X.insert(X.end(), asked[i]->X, asked[i]->X + asked[i]->n * dimension);
+        n += asked[i]->n;
+    }
+    return n;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void EvaluationChannel::tell(const double *fitness, size_t n)
+{
+    unique_lock<mutex> lock(channelMutex);
+
+    size_t expected = 0;
+    for (unsigned i = 0; i < asked.size(); ++i)
+        expected += asked[i]->n;
+
+    if (n != expected)
+    {
+        cerr << "tell() received " << n << " values, " << expected << " expected in EvaluationChannel" << endl;
+        exit(1);
+    }
+
+    for (unsigned i = 0; i < asked.size(); ++i)
+    {
+        copy(fitness, fitness + asked[i]->n, asked[i]->out);
+        fitness += asked[i]->n;
+        asked[i]->done = true;
+    }
+    asked.clear();
+
+    resultAvailable.notify_all();
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void EvaluationChannel::finish()
+{
+    unique_lock<mutex> lock(channelMutex);
+    finished = true;
+    requestAvailable.notify_all();
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void EvaluationChannel::close()
+{
+    unique_lock<mutex> lock(channelMutex);
+    closed = true;
+    pending.clear();
+    asked.clear();
+    requestAvailable.notify_all();
+    resultAvailable.notify_all();
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+AskTellFitness::AskTellFitness(EvaluationChannel &_channel, EvaluationBudget &_budget, unsigned _dimension, double _minX, double _maxX) :
+    channel(_channel), budget(_budget)
+{
+    dimension = _dimension;
+    minX = _minX;
+    maxX = _maxX;
+    ID = 0;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void AskTellFitness::computeBatch(const double *X, size_t n, double *out)
+{
+    if (!channel.submit(X, n, out))
+        budget.reserve(UINT_MAX);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+double AskTellFitness::compute(double *x)
+{
+    double f;
+    computeBatch(x, 1, &f);
+    return f;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+double AskTellFitness::compute(vector<double> x)
+{
+    return compute(&x[0]);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+AskTellCCDE::AskTellCCDE(unsigned dimension, double minX, double maxX) :
+    channel(dimension), fitness(channel, ccde.budget, dimension, minX, maxX), started(false), silentLog(NULL)
+{
+    ccde.setLog(silentLog);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+AskTellCCDE::~AskTellCCDE()
+{
+    if (started)
+    {
+        channel.close();
+        optimizerThread.join();
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void AskTellCCDE::setCycleMode(typeOfCycle mode, unsigned numThreads)
+{
+    //all the workers submit their candidates to the same channel
+    ccde.setCycleMode(mode, numThreads, [this]()
+    {
+        return new AskTellFitness(channel, ccde.budget, fitness.getDimension(), fitness.getMinX(), fitness.getMaxX());
+    });
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void AskTellCCDE::start(unsigned int maxNumberOfEvaluations,
+                        unsigned sizeOfSubcomponents,
+                        unsigned individualsPerSubcomponent,
+                        int seed,
+                        typeOfSurrogate sType,
+                        unsigned numItePerCycle)
+{
+    if (started)
+    {
+        cerr << "AskTellCCDE already started" << endl;
+        exit(1);
+    }
+
+    started = true;
+    optimizerThread = thread([=]()
+    {
+        ccde.optimize(&fitness, maxNumberOfEvaluations, sizeOfSubcomponents, individualsPerSubcomponent,
+                      convergence, seed, sType, numItePerCycle);
+        channel.finish();
+    });
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+unsigned AskTellCCDE::ask(vector<double> &X)
+{
+    return channel.ask(X);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void AskTellCCDE::tell(const vector<double> &fitnessValues)
+{
+    channel.tell(fitnessValues.data(), fitnessValues.size());
+}
@@ -0,0 +1,162 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : AskTellCCDE.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "CCDE.h"
+#include "BatchFitness.h"
+
+using namespace std;
+
+
+/**
+	@brief Rendezvous between the optimizer, which submits batches of candidates, and the caller,
+	which evaluates them. Every evaluation of the optimizer (parents, offspring, surrogate
+	verification, collaborators and context vector) goes through submit(), which blocks until the
+	caller has answered with tell().
+*/
+class EvaluationChannel
+{
+    struct Request
+    {
+        const double *X;
+        size_t n;
+        double *out;
+        bool done;
+    };
+
+    unsigned dimension;
+    mutex channelMutex;
+    condition_variable requestAvailable;
+    condition_variable resultAvailable;
+
+    ///requests not yet returned by ask(), and requests waiting for tell()
+    vector<Request*> pending;
+    vector<Request*> asked;
+
+    bool finished;
+    bool closed;
+
+public:
+    EvaluationChannel(unsigned _dimension);
+
+    ///Called by the optimizer: blocks until the fitness of the n points in X is available in out.
+    ///Returns false if the channel has been closed, in which case out is filled with infinite values
+    bool submit(const double *X, size_t n, double *out);
+
+    ///Called by the caller: collects all the submitted candidates in X, row by row; returns 0 when the optimization is over
+    unsigned ask(vector<double> &X);
+
+    ///Called by the caller: fitness of the candidates returned by the last ask(), in the same order
+    void tell(const double *fitness, size_t n);
+
+    ///Called by the optimizer thread when the optimization is over
+    void finish();
+
+    ///Stop serving requests: pending and future submissions get an infinite fitness
+    void close();
+};
+
+
+/**
+	@brief Objective function whose values are provided from outside through an EvaluationChannel
+*/
+class AskTellFitness : public BatchFitness
+{
+    EvaluationChannel &channel;
+
+    ///exhausted when the channel is closed, so that the optimizer stops as soon as possible
+    EvaluationBudget &budget;
+
+public:
+    AskTellFitness(EvaluationChannel &_channel, EvaluationBudget &_budget, unsigned _dimension, double _minX, double _maxX);
+
+    virtual void computeBatch(const double *X, size_t n, double *out);
+    virtual double compute(double *x);
+    virtual double compute(vector<double> x);
+    virtual void createIdealGroups() {};
+    virtual double getMinX() { return minX; }
+    virtual double getMaxX() { return maxX; }
+    virtual unsigned getID() { return ID; }
+    virtual unsigned getDimension() { return dimension; }
+};
+
+
+/**
+	@brief Ask/tell interface to CCDE, for embedding the optimizer in applications that evaluate the
+	objective function themselves.
+
+	Threading model: this is not a state machine stepped by the caller. start() runs the usual
+	CCDE::optimize loop on a thread owned by this object, and every exact evaluation of that loop
+	becomes a blocking submission to the channel:
+	- ask() blocks the caller until the optimizer has submitted candidates (or has finished), and
+	  returns everything submitted so far;
+	- while the caller evaluates them, the optimizer thread (and, in parallel mode, the workers that
+	  submitted them) is blocked waiting for tell();
+	- tell() wakes the optimizer, which runs its bookkeeping (selection, adaptation, surrogates,
+	  merge of the context vector) up to its next submission while the next ask() waits.
+	So the bookkeeping of one optimizer never overlaps the evaluation of its own candidates: the
+	two sides take turns. Overlap comes from running several AskTellCCDE objects, whose candidates
+	can be evaluated together while the others compute, or from the parallel cycle (setCycleMode),
+	where the workers submit concurrently and one ask() collects all their candidates.
+	ask() and tell() must be called from one thread at a time, in alternation.
+
+	The progress report of CCDE is discarded by default; call ccde.setLog to receive it.
+*/
+class AskTellCCDE
+{
+public:
+    CCDE ccde;
+    vector<ConvPlotPoint> convergence;
+
+private:
+    EvaluationChannel channel;
+    AskTellFitness fitness;
+    thread optimizerThread;
+    bool started;
+
+    ///stream without a buffer, which discards the progress report
+    ostream silentLog;
+
+public:
+    AskTellCCDE(unsigned dimension, double minX, double maxX);
+
+    ///Stop the optimizer, if still running, and wait for its thread
+    ~AskTellCCDE();
+
+    ///Optimize the subcomponents sequentially or in parallel; must be called before start()
+    void setCycleMode(typeOfCycle mode, unsigned numThreads);
+
+    ///Groups of variables known to interact, followed by the separable variables (see Fitness::idealGroups),
+    ///used with ccde.setDecompositionMode(dIdeal, ...); must be called before start()
+    void setIdealGroups(const vector< vector<unsigned> > &groups) { fitness.idealGroups = groups; }
+
+    ///Start the optimization with the same parameters as CCDE::optimize
+    void start(unsigned int maxNumberOfEvaluations,
+               unsigned sizeOfSubcomponents,
+               unsigned individualsPerSubcomponent,
+               int seed,
+               typeOfSurrogate sType,
+               unsigned numItePerCycle);
+
+    ///Candidates to evaluate, row by row; returns their number, 0 when the optimization is over
+    unsigned ask(vector<double> &X);
+
+    ///Fitness of the candidates returned by the last ask()
+    void tell(const vector<double> &fitnessValues);
+};
@@ -0,0 +1,51 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : BatchFitness.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "BatchFitness.h"
+
+using namespace std;
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void BatchFitness::computeBatch(const double *X, size_t n, double *out)
+{
+    size_t dim = getDimension();
+    for (size_t i = 0; i < n; ++i)
+        out[i] = compute(const_cast<double*>(X + i*dim));
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void computeBatch(Fitness *f, const double *X, size_t n, double *out)
+{
+    BatchFitness *bf = dynamic_cast<BatchFitness*>(f);
+    if (bf)
+    {
+        bf->computeBatch(X, n, out);
+        return;
+    }
+
+    size_t dim = f->getDimension();
+    for (size_t i = 0; i < n; ++i)
+        out[i] = f->compute(const_cast<double*>(X + i*dim));
+}
@@ -0,0 +1,37 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : BatchFitness.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <cstddef>
+#include "Fitness.h"
+
+using namespace std;
+
+
+/**
+	@brief Objective function able to evaluate many points in one call.
+	Objectives that can vectorize or parallelize a batch derive from this class and override computeBatch;
+	the default implementation evaluates the points one at a time.
+*/
+class BatchFitness : public Fitness
+{
+public:
+    ///Evaluate the n points stored row by row in X (n x getDimension() values) and write the results in out
+    virtual void computeBatch(const double *X, size_t n, double *out);
+};
+
+
+///Evaluate a batch with any objective: uses BatchFitness::computeBatch when available, otherwise compute() in a loop
+void computeBatch(Fitness *f, const double *X, size_t n, double *out);
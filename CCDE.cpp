@@ -18,7 +18,10 @@
 #include "CCDE.h"
 #include "Decomposer.h"
 #include "JADE.h"
+#include "DifferentialGrouping.h"
 #include <ctime>
+#include <chrono>
+#include <mutex>
 
 using namespace std;
 
@@ -34,6 +37,222 @@ CCDE::CCDE()
     JADE_p = 0.1;
 
     JADE_mutationStrategy = 1;
+
+    cycleMode = cSequential;
+    numThreads = 0;
+    pool = NULL;
+
+    generationMode = gGenerational;
+    numInFlight = 0;
+
+    allocationMode = aUniform;
+    contributionShare = 0.5;
+
+    regroupingMode = rAll;
+    regroupingInterval = 1;
+
+    decompositionMode = dRandom;
+    groupingEvaluations = 0;
+
+    mergeMode = mSequential;
+
+    numIslands = 1;
+    migrationInterval = 1;
+
+    checkpointInterval = 0;
+    resumeFromCheckpoint = false;
+    lastCheckpoint = 0;
+
+    maxBatchValues = (size_t)1 << 20;
+
+    log = &cout;
+
+    optimizerPool = &ownOptimizerPool;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CCDE::setCycleMode(typeOfCycle mode, unsigned _numThreads, function<Fitness*()> _fitnessGenerator)
+{
+    cycleMode = mode;
+    numThreads = _numThreads;
+    fitnessGenerator = _fitnessGenerator;
+
+    if (cycleMode == cParallel && !fitnessGenerator)
+    {
+        cerr << "parallel cycle requires a generator of objective functions" << endl;
+        exit(1);
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CCDE::setGenerationMode(typeOfGeneration mode, unsigned _numInFlight)
+{
+    generationMode = mode;
+    numInFlight = _numInFlight;
+
+    if (generationMode == gSteadyState && numInFlight == 0)
+    {
+        cerr << "steady-state JADE requires at least one evaluation in flight" << endl;
+        exit(1);
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CCDE::setAllocationMode(typeOfAllocation mode, double _contributionShare)
+{
+    allocationMode = mode;
+    contributionShare = _contributionShare;
+
+    if (!(contributionShare >= 0 && contributionShare <= 1))
+    {
+        cerr << "the share of the generations allocated by contribution must be between 0 and 1" << endl;
+        exit(1);
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CCDE::setRegroupingMode(typeOfRegrouping mode, unsigned interval)
+{
+    regroupingMode = mode;
+    regroupingInterval = max(1u, interval);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CCDE::setDecompositionMode(typeOfDecomposition mode, unsigned maxEvaluations, string cacheFile)
+{
+    decompositionMode = mode;
+    groupingEvaluations = maxEvaluations;
+    groupingCacheFile = cacheFile;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CCDE::setMergeMode(typeOfMerge mode)
+{
+    mergeMode = mode;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CCDE::setIslandMode(unsigned _numIslands, unsigned _migrationInterval)
+{
+    numIslands = _numIslands;
+    migrationInterval = _migrationInterval;
+
+    if (numIslands == 0 || migrationInterval == 0)
+    {
+        cerr << "island mode requires at least one island and one cycle between migrations" << endl;
+        exit(1);
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CCDE::setSubcomponentSizes(vector<unsigned> sizes)
+{
+    subcomponentSizes = sizes;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CCDE::setLog(ostream &os)
+{
+    log = &os;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CCDE::setOptimizerPool(JADEPool &pool)
+{
+    optimizerPool = &pool;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CCDE::setBounds(const vector<double> &lower, const vector<double> &upper)
+{
+    lowerBound = lower;
+    upperBound = upper;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CCDE::setCheckpoint(string file, unsigned interval, bool resume)
+{
+    checkpointFile = file;
+    checkpointInterval = interval;
+    resumeFromCheckpoint = resume;
+
+    if (!checkpointFile.empty() && checkpointInterval == 0)
+    {
+        cerr << "checkpoints require at least one cycle between two of them" << endl;
+        exit(1);
+    }
 }
 
 
@@ -54,6 +273,18 @@ Decomposer * CCDE::createDecomposer(unsigned sizeOfSubcomponents, unsigned indiv
 
     unsigned seed = unifRandom(eng)*100000;
 
+    if ( !learnedGroups.empty() )
+    {
+        vector<unsigned> groupSizes;
+        allCoordinates.clear();
+        for (unsigned g = 0; g < learnedGroups.size(); ++g)
+        {
+            allCoordinates.insert(allCoordinates.end(), learnedGroups[g].begin(), learnedGroups[g].end());
+            groupSizes.push_back(learnedGroups[g].size());
+        }
+        return new Decomposer(*this, seed, allCoordinates, sizeOfSubcomponents, individualsPerSubcomponent, population, contextVector, optimum, false, sType, true, groupSizes);
+    }
+
     return new Decomposer(*this, seed, allCoordinates, sizeOfSubcomponents, individualsPerSubcomponent, population, contextVector, optimum, RG, sType);
 }
 
@@ -74,7 +305,7 @@ void CCDE::initPopulation(unsigned numOfIndividuals)
     {
         vector< double > position;
         for (unsigned int d = 0; d<problemDimension; ++d)
-            position.push_back(lowerLimit + unifRandom(eng)*(upperLimit - lowerLimit));
+            position.push_back(lowerBound[d] + unifRandom(eng)*(upperBound[d] - lowerBound[d]));
         population.push_back(position);
         fitnessValues.push_back(0);
     }
@@ -82,6 +313,23 @@ void CCDE::initPopulation(unsigned numOfIndividuals)
 
 
 
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+Fitness *CCDE::getFitness()
+{
+    //the objective functions keep internal buffers, so each worker uses its own copy
+    int w = ThreadPool::workerIndex();
+    if (w >= 0 && w < (int)workerFitness.size())
+        return workerFitness[w];
+
+    return fitness;
+}
+
+
+
 //******************************************************************************************/
 //
 //
@@ -89,19 +337,68 @@ void CCDE::initPopulation(unsigned numOfIndividuals)
 //******************************************************************************************/
 double CCDE::computeFitnessValue(vector<double> &x)
 {
-    return fitness->compute(&x[0]);
+    return getFitness()->compute(&x[0]);
 }
 
 
 
 //******************************************************************************************/
 //
+// X holds n points of problemDimension coordinates, stored row by row
 //
+//******************************************************************************************/
+void CCDE::computeFitnessValues(const double *X, size_t n, double *out)
+{
+    if (n)
+        computeBatch(getFitness(), X, n, out);
+}
+
+
+
+//******************************************************************************************/
+//
+// Batches never exceed maxBatchValues values (but hold at least one candidate), so that the
+// buffer does not grow with the number of subcomponents when the problem is large. The buffer
+// is reached through a plain pointer in the parallel loop, since the workers have their own
 //
 //******************************************************************************************/
-CCDE::~CCDE()
+void CCDE::evaluateCandidates(size_t n, const function<void(size_t, double*)> &fill, double *out, bool parallel)
 {
+    static thread_local vector<double> buffer;
 
+    size_t D = problemDimension;
+    size_t rowsPerBatch = max((size_t)1, maxBatchValues / D);
+
+    for (size_t first = 0; first < n; first += rowsPerBatch)
+    {
+        size_t rows = min(rowsPerBatch, n - first);
+        buffer.resize(rows * D);
+        double *X = buffer.data();
+        for (size_t r = 0; r < rows; ++r)
+            fill(first + r, X + r * D);
+
+        if (parallel)
+            pool->parallelFor(rows, [this, X, D, out, first](unsigned r)
+            {
+                computeFitnessValues(X + r * D, 1, out + first + r);
+            });
+        else
+            computeFitnessValues(X, rows, out + first);
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+CCDE::~CCDE()
+{
+    delete pool;
+    for (unsigned i = 0; i < workerFitness.size(); ++i)
+        delete workerFitness[i];
 }
 
 
@@ -119,8 +416,12 @@ void CCDE::initContextVector()
     for (unsigned i = 0; i < problemDimension; ++i)
         contextVector[i] = population[0][i];
 
-    globalBesdouble = computeFitnessValue(contextVector);
-    numberOfEvaluations++;
+    globalBesdouble = std::numeric_limits<double>::infinity();
+    if (budget.reserve(1))
+    {
+        globalBesdouble = computeFitnessValue(contextVector);
+        budget.commit(eInitialization, 1);
+    }
 }
 
 
@@ -159,77 +460,656 @@ void CCDE::optimize(Fitness* f,
 
     optimum = 0;
 
-    numberOfEvaluations = 0;
-
-    maxNumberOfEvaluations = _maxNumberOfEvaluations;
+    budget.reset(_maxNumberOfEvaluations);
+    scratchUsage.clear();
 
     clock_t startTime = clock();
+    chrono::steady_clock::time_point wallStart = chrono::steady_clock::now();
+
+    if (generationMode == gSteadyState)
+    {
+        if (cycleMode != cSequential || !fitnessGenerator || sType != sNone)
+        {
+            cerr << "steady-state JADE requires the sequential cycle, a generator of objective functions and no surrogate" << endl;
+            exit(1);
+        }
+    }
+
+    if (numIslands > 1)
+    {
+        if (cycleMode != cSequential || generationMode != gGenerational || !fitnessGenerator)
+        {
+            cerr << "islands require the sequential generational cycle and a generator of objective functions" << endl;
+            exit(1);
+        }
+    }
 
     problemDimension = fitness->getDimension();
 
-	lowerLimit = fitness->getMinX();
+    if (decompositionMode == dIdeal && fitness->idealGroups.empty())
+    {
+        cerr << "the objective function does not provide its groups of variables" << endl;
+        exit(1);
+    }
 
-	upperLimit = fitness->getMaxX();
+    if (subcomponentSizes.size() > 1 && decompositionMode != dRandom)
+    {
+        cerr << "the adaptive size of subcomponents requires random grouping" << endl;
+        exit(1);
+    }
+
+    if (subcomponentSizes.size() > 1)
+    {
+        if (find(subcomponentSizes.begin(), subcomponentSizes.end(), _sizeOfSubcomponents) == subcomponentSizes.end())
+        {
+            cerr << "the size of subcomponents must be one of the candidate sizes" << endl;
+            exit(1);
+        }
+        for (unsigned i = 0; i < subcomponentSizes.size(); ++i)
+            if (subcomponentSizes[i] < 1 || problemDimension % subcomponentSizes[i] != 0)
+            {
+                cerr << "the candidate sizes of subcomponents must divide the problem dimension" << endl;
+                exit(1);
+            }
+    }
+
+    if (lowerBound.empty() && upperBound.empty())
+    {
+        lowerBound.assign(problemDimension, fitness->getMinX());
+        upperBound.assign(problemDimension, fitness->getMaxX());
+    }
+    if (lowerBound.size() != problemDimension || upperBound.size() != problemDimension)
+    {
+        cerr << "the bounds must have one value for each variable" << endl;
+        exit(1);
+    }
+
+    CheckpointReader checkpoint;
+    bool resumed = resumeFromCheckpoint && checkpoint.load(checkpointFile);
 
     initPopulation(individualsPerSubcomponent);
 
-    initContextVector();
+    if (!resumed)
+        initContextVector();
+
+    learnedGroups.clear();
+    if (decompositionMode == dDifferential || decompositionMode == dDifferentialCapped)
+        learnGroups(_sizeOfSubcomponents);
+    else if (decompositionMode == dIdeal)
+    {
+        learnedGroups = subcomponentsFromGroups(fitness->idealGroups, _sizeOfSubcomponents, true);
+
+        size_t smallest = problemDimension, largest = 0;
+        for (unsigned g = 0; g < learnedGroups.size(); ++g)
+        {
+            smallest = min(smallest, learnedGroups[g].size());
+            largest = max(largest, learnedGroups[g].size());
+        }
+        *log << "Groups of the objective function: " << learnedGroups.size() << " subcomponents of " << smallest << " to " << largest << " variables" << endl;
+    }
+
+    //each island gets its own random grouping and its own pseudorandom generator
+    vector<Decomposer*> islands;
+    for (unsigned k = 0; k < numIslands; ++k)
+    {
+        islands.push_back(createDecomposer(_sizeOfSubcomponents, individualsPerSubcomponent, sType, true));
+        if (subcomponentSizes.size() > 1)
+        {
+            islands[k]->candidateSizes = subcomponentSizes;
+            islands[k]->sizePerformance.assign(subcomponentSizes.size(), -1.0);
+        }
+    }
+
+    //the decomposers keep their own copy, laid out by their grouping
+    vector< vector<double> >().swap(population);
 
-    Decomposer *dec = createDecomposer(_sizeOfSubcomponents, individualsPerSubcomponent, sType, true);
+    //with adaptive size, the smallest size gives the most subcomponents
+    unsigned maxSubcomponents = 0;
+    for (unsigned k = 0; k < islands.size(); ++k)
+        maxSubcomponents = max(maxSubcomponents, (unsigned)islands[k]->optimizers.size());
+    for (unsigned i = 0; i < subcomponentSizes.size(); ++i)
+        maxSubcomponents = max(maxSubcomponents, problemDimension / subcomponentSizes[i]);
+    budget.trackSubcomponents(maxSubcomponents);
 
-    for (int j = 0; j < dec->optimizers.size(); j++)
+    ite = 0;
+    if (resumed)
     {
-        JADE *optimizer = dec->optimizers[j];
-        optimizer->loadIndividuals(dec->population);
-        optimizer->evaluateParents();
-        numberOfEvaluations += optimizer->nfe;
-        optimizer->nfe = 0;
+        loadCheckpoint(checkpoint, islands, convergence);
+        *log << "Resumed from " << checkpointFile << " at cycle " << ite << "  NOE=" << budget.getUsed() << endl;
     }
 
-    convergence.push_back(ConvPlotPoint(numberOfEvaluations, fabs(globalBesdouble - optimum), 0.0));
+    //no workers are needed to resume a run that had already completed
+    if ((cycleMode == cParallel || generationMode == gSteadyState || numIslands > 1) && !budget.exhausted())
+    {
+        pool = new ThreadPool(numThreads);
+        for (unsigned i = 0; i < pool->size(); ++i)
+            workerFitness.push_back(fitnessGenerator());
+    }
+
+    if (!resumed)
+    {
+        if (numIslands > 1)
+        {
+            pool->parallelFor(islands.size(), [&islands](unsigned k)
+            {
+                Decomposer *dec = islands[k];
+                for (unsigned j = 0; j < dec->optimizers.size(); ++j)
+                    dec->optimizers[j]->loadIndividuals(dec->population);
+                dec->evaluateAllParents();
+            });
+        }
+        else
+        {
+            Decomposer *dec = islands[0];
+            for (unsigned j = 0; j < dec->optimizers.size(); ++j)
+                dec->optimizers[j]->loadIndividuals(dec->population);
+            dec->evaluateAllParents();
+        }
+
+        convergence.push_back(ConvPlotPoint(budget.getUsed(), fabs(globalBesdouble - optimum), 0.0));
 
-    cout << "Cycle=" << 0 << "  NOE=" << numberOfEvaluations << "  err=" << std::scientific << fabs(globalBesdouble - optimum) << endl;
+        *log << "Cycle=" << 0 << "  NOE=" << budget.getUsed() << "  err=" << std::scientific << fabs(globalBesdouble - optimum) << endl;
+    }
+    lastCheckpoint = ite;
+    unsigned usedAtStart = budget.getUsed();
 
-    for (ite = 0; numberOfEvaluations<maxNumberOfEvaluations; ++ite)
+    if (numIslands > 1)
+        optimizeIslands(islands, numItePerCycle, convergence);
+    else
     {
-        clock_t begin = clock();
-        bool surrogateFailure = false;
+        Decomposer *dec = islands[0];
+
+        while (!budget.exhausted())
+        {
+            clock_t begin = clock();
+
+            unsigned size = dec->sizeOfSubcomponents;
+
+            optimizeCycle(dec, numItePerCycle);
+
+            regroup(dec);
+
+            ++ite;
+
+            double error = fabs(dec->bestAchievedFitness - optimum);
+
+            clock_t end = clock();
+            double timeSec = (end - begin) / static_cast<double>(CLOCKS_PER_SEC);
 
+            *log << "Cycle=" << ite << "  NOE=" << budget.getUsed() << "  err=" << std::scientific << error;
+            if (allocationMode == aContribution)
+                *log << "  generations per subcomponent: min=" << *min_element(dec->generations.begin(), dec->generations.end())
+                     << " max=" << *max_element(dec->generations.begin(), dec->generations.end());
+            if (subcomponentSizes.size() > 1)
+                *log << "  subcomponent size=" << size;
+            *log << endl;
+
+            convergence.push_back(ConvPlotPoint(budget.getUsed(), error, 0.0));
+            convergence.back().generations = dec->generations;
+
+            checkpointIfDue(islands, convergence);
+        }
+    }
+    checkpointOutput.wait();
+    clock_t stopTime = clock();
+    elapsedTime = ((double)(stopTime - startTime))/CLOCKS_PER_SEC;
+    wallTime = chrono::duration<double>(chrono::steady_clock::now() - wallStart).count();
+    throughput = wallTime > 0 ? (budget.getUsed() - usedAtStart) / wallTime : 0;
+    *log << "elapsed time = " << elapsedTime << " s" << endl;
+    *log << "wall time = " << wallTime << " s  throughput = " << throughput << " evaluations/s";
+    if (generationMode == gSteadyState)
+        *log << " (steady-state, " << numInFlight << " evaluations in flight)" << endl;
+    else
+        *log << " (generational)" << endl;
+    budget.printBreakdown(*log);
+    scratchUsage.print(*log);
+
+    for (unsigned k = 0; k < islands.size(); ++k)
+    {
+        if (islands[k]->bestAchievedFitness < globalBesdouble)
+        {
+            globalBesdouble = islands[k]->bestAchievedFitness;
+            contextVector = islands[k]->contextVector;
+        }
+        delete islands[k];
+    }
+
+    delete pool;
+    pool = NULL;
+    for (unsigned i = 0; i < workerFitness.size(); ++i)
+        delete workerFitness[i];
+    workerFitness.clear();
+}
+
+
+
+//******************************************************************************************/
+//
+// One cycle of cooperative coevolution, without the regrouping: every optimizer runs for the
+// generations allocated to it, then the collaborators are merged into the context vector
+//
+//******************************************************************************************/
+void CCDE::optimizeCycle(Decomposer *dec, unsigned numItePerCycle)
+{
+    double fitnessAtCycleStart = dec->bestAchievedFitness;
+    unsigned evaluationsAtCycleStart = dec->evaluationsOfOptimizers();
+
+    //hold back the evaluations needed by buildContextVector, so that the optimizers cannot consume them
+    unsigned reservedForContextVector = budget.reserve(dec->optimizers.size() + 1);
+
+    dec->allocateGenerations(numItePerCycle);
+
+    if (cycleMode == cParallel)
+        optimizeSubcomponentsInParallel(dec);
+    else
+    {
         for (unsigned j = 0; j < dec->optimizers.size(); j++)
         {
             JADE *optimizer = dec->optimizers[j];
 
             optimizer->loadIndividuals(dec->population);
-            optimizer->optimize(numItePerCycle);
+            optimizer->optimize(dec->generations[j]);
             optimizer->storeIndividuals(dec->population);
-            numberOfEvaluations += optimizer->nfe;
-            optimizer->nfe = 0;	
-			
-			if (numberOfEvaluations >= maxNumberOfEvaluations - dec->optimizers.size())
-				break;
+
+            if (budget.exhausted())
+                break;
         }
+    }
 
-		dec->buildContextVector();
+    dec->buildContextVector(reservedForContextVector);
 
-        for (unsigned j = 0; j < dec->optimizers.size(); ++j)
-            dec->optimizers[j]->emptyArchive();
+    dec->updateContributions();
 
-		if( numberOfEvaluations<=maxNumberOfEvaluations - (dec->optimizers.size()*dec->individualsPerSubcomponent + dec->optimizers.size()))
-          dec->randomGrouping();
+    for (unsigned j = 0; j < dec->optimizers.size(); ++j)
+        dec->optimizers[j]->emptyArchive();
+
+    //the cost of a cycle includes the evaluations of the regrouping that preceded it
+    if (subcomponentSizes.size() > 1)
+        dec->updateSizePerformance(fitnessAtCycleStart, dec->evaluationsOfOptimizers() - evaluationsAtCycleStart +
+                                   dec->regroupingEvaluations);
+}
+
+
+
+//******************************************************************************************/
+//
+// Learn the groups of interacting variables before the first cycle. Runs sharing a cache file
+// take turns, so that each of them reuses the evaluations of the previous ones
+//
+//******************************************************************************************/
+void CCDE::learnGroups(unsigned sizeOfSubcomponents)
+{
+    static mutex cacheMutex;
+    unique_lock<mutex> lock(cacheMutex, defer_lock);
+    if (!groupingCacheFile.empty())
+        lock.lock();
 
-        double error = fabs(dec->bestAchievedFitness - optimum);
+    DifferentialGrouping grouping(*this);
+    if (!groupingCacheFile.empty())
+        grouping.loadCache(groupingCacheFile);
 
-        clock_t end = clock();
-        double timeSec = (end - begin) / static_cast<double>(CLOCKS_PER_SEC);
+    grouping.learn(groupingEvaluations);
 
-        cout << "Cycle=" << ite + 1 << "  NOE=" << numberOfEvaluations << "  err=" << std::scientific << error << endl;
+    if (!groupingCacheFile.empty() && grouping.performedEvaluations > 0)
+        grouping.saveCache(groupingCacheFile);
 
-        convergence.push_back(ConvPlotPoint(numberOfEvaluations, error, 0.0));
+    learnedGroups = subcomponentsFromGroups(grouping.groups(), sizeOfSubcomponents, decompositionMode == dDifferentialCapped);
+
+    size_t smallest = problemDimension, largest = 0;
+    for (unsigned g = 0; g < learnedGroups.size(); ++g)
+    {
+        smallest = min(smallest, learnedGroups[g].size());
+        largest = max(largest, learnedGroups[g].size());
+    }
+    *log << "Differential grouping: " << grouping.performedEvaluations << " evaluations (" << grouping.reusedEvaluations
+         << " reused from cache), " << learnedGroups.size() << " subcomponents of " << smallest << " to " << largest << " variables" << endl;
+}
+
+
+
+//******************************************************************************************/
+//
+// Subcomponents from groups laid out as Fitness::idealGroups: nonseparable groups followed by
+// the separable variables. Groups sharing a variable (overlapping metadata) are merged, and
+// variables not listed anywhere are separable. With split, groups larger than maxSize are cut
+// in pieces of maxSize, each a subcomponent. Groups smaller than maxSize are packed together,
+// whole, into subcomponents of at most maxSize variables, which the separable variables then
+// fill up. Packing the remainders of the split groups as well was worse on f4
+//
+//******************************************************************************************/
+vector< vector<unsigned> > CCDE::subcomponentsFromGroups(const vector< vector<unsigned> > &groups, unsigned maxSize, bool split)
+{
+    vector<unsigned> parent(problemDimension);
+    for (unsigned i = 0; i < problemDimension; ++i)
+        parent[i] = i;
+    auto root = [&parent](unsigned i)
+    {
+        while (parent[i] != i)
+            i = parent[i] = parent[parent[i]];
+        return i;
+    };
+
+    for (unsigned g = 0; g < groups.size(); ++g)
+        for (unsigned k = 0; k < groups[g].size(); ++k)
+            if (groups[g][k] >= problemDimension)
+            {
+                cerr << "variable " << groups[g][k] << " of the groups out of the problem dimension" << endl;
+                exit(1);
+            }
+
+    for (unsigned g = 0; g + 1 < groups.size(); ++g)
+        for (unsigned k = 1; k < groups[g].size(); ++k)
+            parent[root(groups[g][k])] = root(groups[g][0]);
+
+    //nonseparable groups in order of their first variable, the others are separable
+    vector< vector<unsigned> > components;
+    vector<unsigned> separable;
+    vector<int> componentOf(problemDimension, -1);
+    vector<unsigned> componentSize(problemDimension, 0);
+    for (unsigned i = 0; i < problemDimension; ++i)
+        componentSize[root(i)]++;
+    for (unsigned i = 0; i < problemDimension; ++i)
+    {
+        unsigned r = root(i);
+        if (componentSize[r] == 1)
+        {
+            separable.push_back(i);
+            continue;
+        }
+        if (componentOf[r] < 0)
+        {
+            componentOf[r] = components.size();
+            components.push_back(vector<unsigned>());
+        }
+        components[componentOf[r]].push_back(i);
+    }
+
+    //next fit: a group that does not fit in the open subcomponent closes it
+    vector< vector<unsigned> > result;
+    vector<unsigned> open;
+    for (unsigned c = 0; c < components.size(); ++c)
+    {
+        vector<unsigned> &component = components[c];
+        if (component.size() >= maxSize)
+        {
+            if (!split)
+                result.push_back(component);
+            else
+                for (unsigned d = 0; d < component.size(); d += maxSize)
+                    result.push_back(vector<unsigned>(component.begin() + d, component.begin() + min((size_t)d + maxSize, component.size())));
+            continue;
+        }
+        if (open.size() + component.size() > maxSize)
+        {
+            result.push_back(open);
+            open.clear();
+        }
+        open.insert(open.end(), component.begin(), component.end());
+        if (open.size() == maxSize)
+        {
+            result.push_back(open);
+            open.clear();
+        }
+    }
+
+    for (unsigned k = 0; k < separable.size(); ++k)
+    {
+        open.push_back(separable[k]);
+        if (open.size() == maxSize)
+        {
+            result.push_back(open);
+            open.clear();
+        }
+    }
+    if (!open.empty())
+        result.push_back(open);
+
+    return result;
+}
+
+
+
+//******************************************************************************************/
+//
+// Random grouping every regroupingInterval cycles, if the budget allows the evaluations it needs;
+// with adaptive size, the size of the subcomponents of the next cycle is selected first
+//
+//******************************************************************************************/
+void CCDE::regroup(Decomposer *dec)
+{
+    dec->regroupingEvaluations = 0;
+    if (!dec->applyRandomGrouping || ++dec->cyclesSinceRegrouping < regroupingInterval)
+        return;
+
+    unsigned size = dec->sizeOfSubcomponents;
+    unsigned numberOfSubcomponents = dec->optimizers.size();
+    if (subcomponentSizes.size() > 1)
+    {
+        size = dec->selectSizeOfSubcomponents();
+        numberOfSubcomponents = problemDimension / size;
+    }
+
+    unsigned evaluations = numberOfSubcomponents;
+    if (regroupingMode == rAll)
+        evaluations += numberOfSubcomponents*dec->individualsPerSubcomponent;
+    else if (regroupingMode == rBest)
+        evaluations += numberOfSubcomponents;
+
+    if (budget.getAvailable() < evaluations)
+        return;
+
+    dec->cyclesSinceRegrouping = 0;
+    if (regroupingMode != rAll)
+        dec->carryOverFitness();
+    dec->setSubcomponentsOfEqualSize(size);
+    dec->randomGrouping();
+}
+
+
+
+//******************************************************************************************/
+//
+// Island model: every island is a decomposer with its own grouping and its own generator, and
+// is optimized by one worker of the pool with a private copy of the objective function. All
+// the islands draw from the same evaluation budget. Every migrationInterval cycles the islands
+// stop and exchange their best context vectors (see migrate); the regrouping that follows the
+// last cycle of an epoch is postponed to the next epoch, so that the parents are re-evaluated
+// against the context vector received by migration. Without a regrouping at that point, the
+// parents are refreshed by Decomposer::refreshParentsFitness.
+//
+//******************************************************************************************/
+void CCDE::optimizeIslands(vector<Decomposer*> &islands, unsigned numItePerCycle, vector<ConvPlotPoint> &convergence)
+{
+    while (!budget.exhausted())
+    {
+        unsigned firstCycle = ite;
+        pool->parallelFor(islands.size(), [this, &islands, firstCycle, numItePerCycle](unsigned k)
+        {
+            Decomposer *dec = islands[k];
+            for (unsigned c = 0; c < migrationInterval && !budget.exhausted(); ++c)
+            {
+                if (firstCycle > 0 || c > 0)
+                    regroup(dec);
+                dec->refreshParentsFitness();
+
+                optimizeCycle(dec, numItePerCycle);
+            }
+        });
+        ite += migrationInterval;
+
+        migrate(islands);
+
+        unsigned best = 0;
+        for (unsigned k = 1; k < islands.size(); ++k)
+            if (islands[k]->bestAchievedFitness < islands[best]->bestAchievedFitness)
+                best = k;
+        double error = fabs(islands[best]->bestAchievedFitness - optimum);
+
+        *log << "Cycle=" << ite << "  NOE=" << budget.getUsed() << "  err=" << std::scientific << error << "  best island=" << best << endl;
+
+        convergence.push_back(ConvPlotPoint(budget.getUsed(), error, 0.0));
+
+        checkpointIfDue(islands, convergence);
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+// Checkpoints are taken at the end of a cycle (of an epoch with islands), when the archives
+// only hold the re-evaluated parents and the surrogates are rebuilt before their next use
+//
+//******************************************************************************************/
+void CCDE::checkpointIfDue(vector<Decomposer*> &islands, vector<ConvPlotPoint> &convergence)
+{
+    if (checkpointFile.empty())
+        return;
+
+    if (ite - lastCheckpoint < checkpointInterval && !budget.exhausted())
+        return;
+
+    saveCheckpoint(islands, convergence);
+    lastCheckpoint = ite;
+}
+
+
+
+//******************************************************************************************/
+//
+// The state is serialized in memory, then written to file by a background thread
+//
+//******************************************************************************************/
+void CCDE::saveCheckpoint(vector<Decomposer*> &islands, vector<ConvPlotPoint> &convergence)
+{
+    CheckpointWriter &w = checkpointWriter;
+    w.clear();
+
+    w.putString("SACCJADE checkpoint v8");
+    w.put(fitness->getID());
+    w.put(problemDimension);
+    w.put((unsigned)islands.size());
+    w.put(islands[0]->individualsPerSubcomponent);
+    w.put((int)islands[0]->sType);
+    w.put(budget.getMax());
+
+    w.put(ite);
+    w.putEngine(eng);
+    for (unsigned i = 0; i < numOfEvaluationTypes; ++i)
+        w.put(budget.getUsed((typeOfEvaluation)i));
+    w.putVector(budget.getUsedBySubcomponent());
+    w.put(globalBesdouble);
+    w.putVector(contextVector);
+
+    w.put((uint64_t)convergence.size());
+    for (unsigned q = 0; q < convergence.size(); ++q)
+    {
+        w.put(convergence[q].nfe);
+        w.put(convergence[q].f);
+        w.put(convergence[q].surrogateError);
+        w.putVector(convergence[q].generations);
+    }
+
+    for (unsigned k = 0; k < islands.size(); ++k)
+        islands[k]->saveState(w);
+
+    checkpointOutput.write(checkpointFile, w);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CCDE::loadCheckpoint(CheckpointReader &r, vector<Decomposer*> &islands, vector<ConvPlotPoint> &convergence)
+{
+    string header;
+    unsigned id, dimension, nIslands, individuals, maxEvaluations;
+    int surrogate;
+
+    r.getString(header);
+    if (header != "SACCJADE checkpoint v8")
+    {
+        cerr << checkpointFile << " is not a SACCJADE checkpoint" << endl;
+        exit(1);
+    }
+
+    r.get(id);
+    r.get(dimension);
+    r.get(nIslands);
+    r.get(individuals);
+    r.get(surrogate);
+    r.get(maxEvaluations);
+    if (id != fitness->getID() || dimension != problemDimension || nIslands != islands.size() ||
+        individuals != islands[0]->individualsPerSubcomponent || surrogate != (int)islands[0]->sType ||
+        maxEvaluations != budget.getMax())
+    {
+        cerr << "the checkpoint " << checkpointFile << " was saved with different parameters" << endl;
+        exit(1);
+    }
+
+    r.get(ite);
+    r.getEngine(eng);
+    unsigned usedByType[numOfEvaluationTypes];
+    for (unsigned i = 0; i < numOfEvaluationTypes; ++i)
+        r.get(usedByType[i]);
+    vector<unsigned> usedBySubcomponent;
+    r.getVector(usedBySubcomponent);
+    budget.restore(usedByType, usedBySubcomponent);
+    r.get(globalBesdouble);
+    r.getVector(contextVector);
+
+    uint64_t n;
+    r.get(n);
+    convergence.clear();
+    for (uint64_t q = 0; q < n; ++q)
+    {
+        unsigned nfe;
+        double f, surrogateError;
+        r.get(nfe);
+        r.get(f);
+        r.get(surrogateError);
+        convergence.push_back(ConvPlotPoint(nfe, f, surrogateError));
+        r.getVector(convergence.back().generations);
+    }
+
+    for (unsigned k = 0; k < islands.size(); ++k)
+        islands[k]->loadState(r);
+}
+
+
+
+//******************************************************************************************/
+//
+// Ring migration: each island receives the context vector of the previous island when it is
+// better than its own. The fitness of its parents is then refreshed at the beginning of the next
+// epoch, on the worker of the island (see Decomposer::refreshParentsFitness)
+//
+//******************************************************************************************/
+void CCDE::migrate(vector<Decomposer*> &islands)
+{
+    unsigned K = islands.size();
+
+    vector< vector<double> > emigrants(K);
+    vector<double> emigrantsFitness(K);
+    for (unsigned k = 0; k < K; ++k)
+    {
+        emigrants[k] = islands[k]->contextVector;
+        emigrantsFitness[k] = islands[k]->bestAchievedFitness;
+    }
+
+    for (unsigned k = 0; k < K; ++k)
+    {
+        unsigned donor = (k + K - 1) % K;
+        if (emigrantsFitness[donor] < islands[k]->bestAchievedFitness)
+        {
+            islands[k]->contextVector = emigrants[donor];
+            islands[k]->bestAchievedFitness = emigrantsFitness[donor];
+            islands[k]->contextVectorReplaced = true;
+        }
     }
-    clock_t stopTime = clock();
-    elapsedTime = ((double)(stopTime - startTime))/CLOCKS_PER_SEC;
-    cout << "elapsed time = " << elapsedTime << " s" << endl;
-    delete dec;
 }
 
 
@@ -248,6 +1128,27 @@ void CCDE::optimizeSubcomponents(Decomposer *dec, unsigned nGenPerIteration)
         optimizer->optimize(nGenPerIteration);
         optimizer->storeIndividuals(dec->population);
     }
-    dec->buildContextVector();
+    dec->buildContextVector(0);
+}
+
+
+
+//******************************************************************************************/
+//
+// Jacobi-style cycle: all the optimizers run concurrently against the context vector of the
+// previous cycle, which is not modified until Decomposer::buildContextVector merges the results.
+// Each optimizer writes back only its own coordinates of the population, and runs for the
+// generations allocated by Decomposer::allocateGenerations.
+//
+//******************************************************************************************/
+void CCDE::optimizeSubcomponentsInParallel(Decomposer *dec)
+{
+    pool->parallelFor(dec->optimizers.size(), [dec](unsigned j)
+    {
+        JADE *optimizer = dec->optimizers[j];
+        optimizer->loadIndividuals(dec->population);
+        optimizer->optimize(dec->generations[j]);
+        optimizer->storeIndividuals(dec->population);
+    });
 }
 
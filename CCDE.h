@@ -27,9 +27,16 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <functional>
 #include "Benchmarks2013.h"
+#include "BatchFitness.h"
 #include "JADE.h"
+#include "JADEPool.h"
 #include "Decomposer.h"
+#include "ThreadPool.h"
+#include "EvaluationBudget.h"
+#include "ScratchArena.h"
+#include "Checkpoint.h"
 #include "numeric"
 
 
@@ -39,6 +46,30 @@
 using namespace std;
 
 
+///How the subcomponents are optimized within a cycle
+typedef enum { cSequential = 0, cParallel } typeOfCycle;
+
+///How JADE replaces the individuals: all at once after each generation, or one at a time as evaluations complete
+typedef enum { gGenerational = 0, gSteadyState } typeOfGeneration;
+
+///How the generations of a cycle are shared among the subcomponents: equally, or according to their contribution (CBCC)
+typedef enum { aUniform = 0, aContribution } typeOfAllocation;
+
+///Which parents are re-evaluated after a random grouping: all of them, only the best one of each subcomponent,
+///or none (they keep a stale fitness, resolved lazily by JADE or by the surrogate)
+typedef enum { rAll = 0, rBest, rStale } typeOfRegrouping;
+
+///How the variables are decomposed: random grouping at each cycle, fixed groups learned by differential
+///grouping, either as they are or with the large groups split to the size of the subcomponents, or fixed
+///groups given by the objective function (Fitness::idealGroups), with the large groups split
+typedef enum { dRandom = 0, dDifferential, dDifferentialCapped, dIdeal } typeOfDecomposition;
+
+///How the collaborators are merged into the context vector at the end of a cycle: one after the
+///other, each evaluated against the context vector updated by the previous ones, or all evaluated
+///in one batch and then merged greedily in groups (see Decomposer::buildContextVector)
+typedef enum { mSequential = 0, mGroups } typeOfMerge;
+
+
 class ConvPlotPoint
 {
 public:
@@ -47,6 +78,9 @@ public:
     double surrogateError;
     unsigned subcomponentSize;
     unsigned individuals;
+
+    ///generations allocated to each subcomponent in the cycle ending at this point
+    vector<unsigned> generations;
     ConvPlotPoint(unsigned  _nfe, double _f, double _surrogateError) :
         nfe(_nfe), f(_f), surrogateError(_surrogateError)
     {};
@@ -58,6 +92,24 @@ public:
 /**
 	@brief Main CCDE class.
 	This class represents multiple swarms of particles which operate on the grouped directions of the main search space.
+
+	Memory model, for D variables, N individuals per subcomponent and m subcomponents:
+	- each decomposer keeps the population (N x D values, see Decomposer::population) and a few vectors
+	  of D values: the context vector, the context vector being merged, the contributions of the variables;
+	- the optimizers together keep their parents and offspring (2 x N x D values) and, with a surrogate,
+	  their archives; without a surrogate no archive is kept. The other state of an optimizer is O(N) plus
+	  O(size of its subcomponent), e.g. the bounds of its variables, i.e. 6 x D values in all;
+	- the optimizers released to the JADEPool are kept: with adaptive size, those of the sizes not in use
+	  add up to 2 x N x D values per size already tried;
+	- CCDE keeps the bounds (2 x D values); its initial population (N x D) is released once the decomposers
+	  are built, so it only adds to the peak. Differential grouping keeps O(D) values (see
+	  DifferentialGrouping);
+	- full-dimensional candidates are only built in buffers shared by all the optimizers running on the
+	  same thread: one candidate, plus batches of at most maxBatchValues values (see evaluateCandidates)
+	  and, in steady-state mode, one candidate per evaluation in flight.
+	Nothing else grows with m. With one island and one thread, the vectors of D values add up to about
+	18 x D, so the peak is about (4 x N + 18) x D values, i.e. 440 MB for D = 10^6 and N = 10; each
+	further island adds about 3 x N x D values. --bench scaling measures it.
 */
 class CCDE
 {
@@ -92,15 +144,91 @@ public:
     void initPopulation(unsigned numOfIndividuals);
     void initContextVector();
     double computeFitnessValue(vector<double> &x);
+    void computeFitnessValues(const double *X, size_t n, double *out);
+    Fitness *getFitness();
     Decomposer *createDecomposer(unsigned sizeOfSubcomponents, unsigned individualsPerSubcomponent, typeOfSurrogate sType, bool random = false);
     void optimizeSubcomponents(Decomposer *dec, unsigned nGenPerIteration);
+    void optimizeSubcomponentsInParallel(Decomposer *dec);
+    void optimizeCycle(Decomposer *dec, unsigned numItePerCycle);
+    void optimizeIslands(vector<Decomposer*> &islands, unsigned numItePerCycle, vector<ConvPlotPoint> &convergence);
+    void migrate(vector<Decomposer*> &islands);
+    void regroup(Decomposer *dec);
+    void learnGroups(unsigned sizeOfSubcomponents);
+    vector< vector<unsigned> > subcomponentsFromGroups(const vector< vector<unsigned> > &groups, unsigned maxSize, bool split);
+    void saveCheckpoint(vector<Decomposer*> &islands, vector<ConvPlotPoint> &convergence);
+    void loadCheckpoint(CheckpointReader &r, vector<Decomposer*> &islands, vector<ConvPlotPoint> &convergence);
+    void checkpointIfDue(vector<Decomposer*> &islands, vector<ConvPlotPoint> &convergence);
+
+    ///Select sequential (Gauss-Seidel) or concurrent (Jacobi) optimization of the subcomponents.
+    ///The generator must return a fresh copy of the objective function, one for each worker thread
+    void setCycleMode(typeOfCycle mode, unsigned numThreads, function<Fitness*()> fitnessGenerator);
+
+    ///Select generational or asynchronous steady-state JADE, the latter keeping numInFlight evaluations
+    ///running on the worker threads. Steady-state requires the sequential cycle, a fitness generator
+    ///(see setCycleMode) and no surrogate
+    void setGenerationMode(typeOfGeneration mode, unsigned numInFlight);
+
+    ///Select uniform or contribution-based allocation of the generations of each cycle; with the
+    ///latter, contributionShare is the fraction of the generations allocated according to the
+    ///contributions, the rest being shared equally (see Decomposer::allocateGenerations)
+    void setAllocationMode(typeOfAllocation mode, double contributionShare = 0.5);
+
+    ///Select which parents are re-evaluated after a random grouping, and regroup only every interval cycles.
+    ///The evaluations spent because of the regrouping are reported separately in the breakdown of the budget
+    void setRegroupingMode(typeOfRegrouping mode, unsigned interval);
+
+    ///Decompose with fixed groups learned by differential grouping (see DifferentialGrouping) at most
+    ///maxEvaluations evaluations (0 -> the complete interaction matrix). The separable variables, and
+    ///with dDifferentialCapped the large groups, are split in groups of the size of the subcomponents.
+    ///With a cache file, the evaluations of previous runs on the same function are reused.
+    ///dIdeal takes the groups from Fitness::idealGroups, which the objective function must fill
+    void setDecompositionMode(typeOfDecomposition mode, unsigned maxEvaluations, string cacheFile);
+
+    ///Select how the collaborators are merged into the context vector. The merge in groups shortens
+    ///the chain of sequential evaluations at the end of a cycle, but ends with a worse context vector
+    ///on the nonseparable functions (e.g. F4), so the sequential merge is the default
+    void setMergeMode(typeOfMerge mode);
+
+    ///Run numIslands independent decomposers, each on its own worker thread and with its own random
+    ///grouping, which exchange their best context vectors every migrationInterval cycles.
+    ///Islands require the sequential generational cycle and a fitness generator (see setCycleMode)
+    void setIslandMode(unsigned numIslands, unsigned migrationInterval);
+
+    ///Adapt the size of the subcomponents at run time (MLCC): before each regrouping, every decomposer
+    ///picks one of sizes according to the improvement per evaluation recently achieved with it.
+    ///The sizes must divide the problem dimension and include the initial size; fewer than two sizes
+    ///keep the size fixed
+    void setSubcomponentSizes(vector<unsigned> sizes);
+
+    ///Save the whole state of the optimizer to file every interval cycles and at the end of the run.
+    ///With resume, optimize() continues from file, if it exists, instead of starting a new run;
+    ///the other parameters of optimize() and the modes must be the same as in the interrupted run
+    void setCheckpoint(string file, unsigned interval, bool resume);
+
+    ///Send the progress report to os instead of the standard output, e.g. to keep apart the
+    ///reports of repetitions running concurrently
+    void setLog(ostream &os);
+
+    ///Take the optimizers from pool and give them back to it, instead of a pool owned by this object;
+    ///a pool shared by the repetitions run by a thread saves allocating their optimizers again
+    void setOptimizerPool(JADEPool &pool);
+
+    ///Bounds of each variable; by default all the variables have the bounds of the objective function
+    void setBounds(const vector<double> &lower, const vector<double> &upper);
+
+    ///Evaluate n full-dimensional candidates: fill(r, x) writes candidate r in x, in increasing order of r,
+    ///and its fitness is written in out[r]. The candidates are built in batches of at most maxBatchValues
+    ///values, in a buffer of the calling thread; with parallel, each candidate of a batch is evaluated
+    ///by a worker. The evaluations must have been reserved
+    void evaluateCandidates(size_t n, const function<void(size_t, double*)> &fill, double *out, bool parallel);
 
     ///Dimensionality of the search space
     unsigned problemDimension;
 
-    ///Number of fitness evaluations
-    unsigned numberOfEvaluations;
-    unsigned maxNumberOfEvaluations;
+    ///Exact fitness evaluations allowed and performed
+    EvaluationBudget budget;
+    ///Temporaries of the optimizers (see JADE::scratch)
+    ScratchUsage scratchUsage;
     unsigned ite;
 
     //JADE parameters
@@ -122,11 +250,12 @@ public:
     ///Fitnesses of population (only for initialization after sub-groups change)
     vector< double > fitnessValues;
 
-    ///Lower limit for each dimension of the search space
-    double lowerLimit;
+    ///Lower and upper limit of each dimension of the search space
+    vector<double> lowerBound;
+    vector<double> upperBound;
 
-    ///Upper limit for each dimension of the search space
-    double upperLimit;
+    ///Largest batch of full-dimensional candidates built at once, in values (see evaluateCandidates)
+    size_t maxBatchValues;
 
     ///index of the best individual
     unsigned int globalBestIndex;
@@ -134,9 +263,68 @@ public:
     ///Last elapsed time
     double elapsedTime;
 
+    ///Last elapsed wall-clock time and exact evaluations per wall-clock second
+    double wallTime;
+    double throughput;
+
     unsigned functionIndex;
 
+    ///Candidate sizes of subcomponents in adaptive mode (see setSubcomponentSizes)
     vector<unsigned> subcomponentSizes;
     vector<unsigned> numIndividualsPerSubcomponents;
+
+    typeOfCycle cycleMode;
+
+    ///Number of worker threads in parallel mode (0 -> number of hardware threads)
+    unsigned numThreads;
+
+    ///Worker threads, allocated only for the duration of a parallel optimization
+    ThreadPool *pool;
+
+    function<Fitness*()> fitnessGenerator;
+
+    typeOfGeneration generationMode;
+
+    ///Evaluations kept in flight by the steady-state JADE (at most the number of individuals per subcomponent)
+    unsigned numInFlight;
+
+    typeOfAllocation allocationMode;
+    double contributionShare;
+
+    typeOfRegrouping regroupingMode;
+
+    ///Cycles between two random groupings
+    unsigned regroupingInterval;
+
+    typeOfDecomposition decompositionMode;
+    unsigned groupingEvaluations;
+    string groupingCacheFile;
+
+    typeOfMerge mergeMode;
+
+    ///Subcomponents learned by differential grouping or given by the objective function (empty -> random grouping)
+    vector< vector<unsigned> > learnedGroups;
+
+    ///Number of islands (1 -> a single decomposer) and cycles between two migrations
+    unsigned numIslands;
+    unsigned migrationInterval;
+
+    ///Checkpoint file (empty -> no checkpoints), cycles between two checkpoints and cycle of the last one
+    string checkpointFile;
+    unsigned checkpointInterval;
+    bool resumeFromCheckpoint;
+    unsigned lastCheckpoint;
+    CheckpointWriter checkpointWriter;
+    CheckpointFile checkpointOutput;
+
+    ///Private copies of the objective function, indexed by ThreadPool::workerIndex()
+    vector<Fitness*> workerFitness;
+
+    ///Stream receiving the progress report (the standard output by default)
+    ostream *log;
+
+    ///Optimizers not in use by any decomposer (ownOptimizerPool, unless set by setOptimizerPool)
+    JADEPool *optimizerPool;
+    JADEPool ownOptimizerPool;
 };
 
@@ -0,0 +1,246 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : Checkpoint.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "Checkpoint.h"
+#include <cstdio>
+#include <iostream>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+using namespace std;
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CheckpointWriter::putVector(const vector<bool> &v)
+{
+    put((uint64_t)v.size());
+    for (size_t i = 0; i < v.size(); ++i)
+        put((char)v[i]);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CheckpointWriter::putString(const string &s)
+{
+    put((uint64_t)s.size());
+    buffer.insert(buffer.end(), s.begin(), s.end());
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+bool CheckpointReader::load(const string &path)
+{
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == NULL)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    buffer.resize(size > 0 ? size : 0);
+    size_t n = buffer.size() ? fread(&buffer[0], 1, buffer.size(), file) : 0;
+    fclose(file);
+
+    if (n != buffer.size())
+    {
+        cerr << "unable to read the checkpoint " << path << endl;
+        exit(1);
+    }
+
+    position = 0;
+    return true;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CheckpointReader::read(void *p, size_t n)
+{
+    if (position + n > buffer.size())
+    {
+        cerr << "truncated or corrupted checkpoint" << endl;
+        exit(1);
+    }
+
+    memcpy(p, &buffer[position], n);
+    position += n;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CheckpointReader::getVector(vector<bool> &v)
+{
+    uint64_t n;
+    get(n);
+    v.resize((size_t)n);
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        char c;
+        get(c);
+        v[i] = c != 0;
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CheckpointReader::getString(string &s)
+{
+    uint64_t n;
+    get(n);
+    s.resize((size_t)n);
+    if (n)
+        read(&s[0], (size_t)n);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+CheckpointFile::~CheckpointFile()
+{
+    wait();
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CheckpointFile::wait()
+{
+    if (writer.joinable())
+        writer.join();
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CheckpointFile::write(const string &path, CheckpointWriter &w)
+{
+    wait();
+    pending.swap(w.buffer);
+    writer = thread(&CheckpointFile::writeAndReplace, this, path);
+}
+
+
+
+//******************************************************************************************/
+//
+// The content of the file reaches the disk before the rename, and the rename before the next
+// checkpoint, so that a crash of the node leaves a complete checkpoint
+//
+//******************************************************************************************/
+void CheckpointFile::writeAndReplace(string path)
+{
+    string temporaryPath = path + ".tmp";
+
+    FILE *file = fopen(temporaryPath.c_str(), "wb");
+    if (file == NULL)
+    {
+        cerr << "unable to write the checkpoint " << temporaryPath << endl;
+        return;
+    }
+
+    size_t n = pending.size() ? fwrite(&pending[0], 1, pending.size(), file) : 0;
+    bool ok = (n == pending.size()) && fflush(file) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok)
+    {
+        cerr << "unable to write the checkpoint " << temporaryPath << endl;
+        remove(temporaryPath.c_str());
+        return;
+    }
+
+#ifdef _WIN32
+    ok = MoveFileExA(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    ok = rename(temporaryPath.c_str(), path.c_str()) == 0 && syncDirectory(path);
+#endif
+
+    if (!ok)
+        cerr << "unable to replace the checkpoint " << path << endl;
+}
+
+
+
+#ifndef _WIN32
+//******************************************************************************************/
+//
+// A rename is durable once the directory holding the file has been synchronized
+//
+//******************************************************************************************/
+bool CheckpointFile::syncDirectory(const string &path)
+{
+    size_t slash = path.find_last_of('/');
+    string directory = slash == string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+
+    int fd = open(directory.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+}
+#endif
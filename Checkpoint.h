@@ -0,0 +1,137 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : Checkpoint.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+
+/**
+	@brief Serializes the state of the optimizer into a memory buffer.
+	Values are stored in their binary representation, vectors are preceded by their size and
+	pseudorandom engines are stored through their textual representation, which is portable.
+	The buffer keeps its capacity between two checkpoints, so that a snapshot allocates nothing.
+*/
+class CheckpointWriter
+{
+public:
+    vector<char> buffer;
+
+    void clear() { buffer.clear(); }
+
+    template<class T> void put(const T &v)
+    {
+        const char *p = (const char*)&v;
+        buffer.insert(buffer.end(), p, p + sizeof(T));
+    }
+
+    template<class T> void putVector(const vector<T> &v)
+    {
+        put((uint64_t)v.size());
+        if (v.size())
+        {
+            const char *p = (const char*)&v[0];
+            buffer.insert(buffer.end(), p, p + sizeof(T) * v.size());
+        }
+    }
+
+    void putVector(const vector<bool> &v);
+    void putString(const string &s);
+
+    template<class Engine> void putEngine(const Engine &e)
+    {
+        ostringstream os;
+        os << e;
+        putString(os.str());
+    }
+};
+
+
+/**
+	@brief Reads back, in the same order, the values stored by CheckpointWriter.
+	A truncated or corrupted file terminates the program.
+*/
+class CheckpointReader
+{
+    vector<char> buffer;
+    size_t position;
+
+    void read(void *p, size_t n);
+
+public:
+    CheckpointReader() : position(0) {};
+
+    ///Load the whole file; returns false if it cannot be opened
+    bool load(const string &path);
+
+    template<class T> void get(T &v) { read(&v, sizeof(T)); }
+
+    template<class T> void getVector(vector<T> &v)
+    {
+        uint64_t n;
+        get(n);
+        v.resize((size_t)n);
+        if (n)
+            read(&v[0], sizeof(T) * (size_t)n);
+    }
+
+    void getVector(vector<bool> &v);
+    void getString(string &s);
+
+    template<class Engine> void getEngine(Engine &e)
+    {
+        string s;
+        getString(s);
+        istringstream is(s);
+        is >> e;
+    }
+};
+
+
+/**
+	@brief Atomic, durable and asynchronous writing of checkpoints.
+	The buffer is written to a temporary file by a background thread, which flushes it to disk and
+	then replaces the previous checkpoint with a rename, flushed as well (the directory on POSIX,
+	MOVEFILE_WRITE_THROUGH on Windows): a crash of the program or of the node at any time leaves
+	either the old or the new checkpoint on disk, never a partial one. The optimizer only pays for
+	the serialization. Every checkpoint holds the whole state: nothing is written incrementally.
+*/
+class CheckpointFile
+{
+    thread writer;
+
+    ///buffer being written by the background thread
+    vector<char> pending;
+
+    void writeAndReplace(string path);
+#ifndef _WIN32
+    static bool syncDirectory(const string &path);
+#endif
+
+public:
+    ~CheckpointFile();
+
+    ///Start writing the content of w to path; w receives the buffer of the previous write, to be reused
+    void write(const string &path, CheckpointWriter &w);
+
+    ///Wait for the write in progress, if any
+    void wait();
+};
@@ -0,0 +1,129 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : CompletionQueue.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "CompletionQueue.h"
+
+using namespace std;
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+CompletionQueue::CompletionQueue() : ready(NULL), capacity(0), writeIndex(0), readIndex(0), consumerWaiting(false)
+{
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+CompletionQueue::~CompletionQueue()
+{
+    delete[] ready;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CompletionQueue::reset(unsigned _capacity)
+{
+    if (_capacity != capacity)
+    {
+        delete[] ready;
+        capacity = _capacity;
+        ready = new atomic<bool>[capacity];
+        entries.resize(capacity);
+    }
+
+    for (unsigned k = 0; k < capacity; ++k)
+        ready[k].store(false);
+
+    writeIndex = 0;
+    readIndex = 0;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void CompletionQueue::push(unsigned slot, double fitness)
+{
+    unsigned k = writeIndex.fetch_add(1) % capacity;
+
+    entries[k].slot = slot;
+    entries[k].fitness = fitness;
+
+    //sequentially consistent with the flag of the consumer: either the consumer sees the result
+    //before sleeping, or this producer sees it asleep and wakes it
+    ready[k].store(true);
+    if (consumerWaiting.load())
+    {
+        lock_guard<mutex> lock(waitMutex);
+        resultAvailable.notify_one();
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+bool CompletionQueue::pop(Completion &c)
+{
+    unsigned k = readIndex % capacity;
+
+    if (!ready[k].load(memory_order_acquire))
+        return false;
+
+    c = entries[k];
+    ready[k].store(false, memory_order_relaxed);
+    ++readIndex;
+    return true;
+}
+
+
+
+//******************************************************************************************/
+//
+// The next result is checked again under the mutex after the flag is raised, so that a result
+// pushed in between is not missed
+//
+//******************************************************************************************/
+void CompletionQueue::wait(Completion &c)
+{
+    if (pop(c))
+        return;
+
+    unique_lock<mutex> lock(waitMutex);
+    consumerWaiting.store(true);
+    resultAvailable.wait(lock, [this] { return ready[readIndex % capacity].load(); });
+    consumerWaiting.store(false);
+    lock.unlock();
+
+    pop(c);
+}
@@ -0,0 +1,73 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : CompletionQueue.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+using namespace std;
+
+
+/**
+	@brief Lock-free multi-producer single-consumer queue of completed evaluations.
+	Worker threads push the fitness of the candidate stored in a slot, and the optimizer pops the results
+	in completion order. The capacity must be at least the number of evaluations in flight: a slot is
+	submitted again only after its previous result has been popped, so the ring never overflows.
+	The consumer can also sleep until a result arrives (wait); a producer takes the mutex only to wake
+	a sleeping consumer.
+*/
+class CompletionQueue
+{
+public:
+    struct Completion
+    {
+        unsigned slot;
+        double fitness;
+    };
+
+private:
+    vector<Completion> entries;
+
+    ///ready[k] is set by the producer once entries[k] has been written
+    atomic<bool> *ready;
+    unsigned capacity;
+
+    atomic<unsigned> writeIndex;
+    unsigned readIndex;
+
+    ///set by the consumer while it sleeps in wait()
+    atomic<bool> consumerWaiting;
+    mutex waitMutex;
+    condition_variable resultAvailable;
+
+public:
+    CompletionQueue();
+    ~CompletionQueue();
+
+    ///Empty the queue and set its capacity; not thread-safe
+    void reset(unsigned _capacity);
+
+    ///Called by any thread
+    void push(unsigned slot, double fitness);
+
+    ///Called by the consumer only: returns false if no result is available yet
+    bool pop(Completion &c);
+
+    ///Called by the consumer only: blocks until a result is available and pops it
+    void wait(Completion &c);
+};
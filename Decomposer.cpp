@@ -18,8 +18,9 @@
 
 #include "Decomposer.h"
 #include "CCDE.h"
-#include "sobol.hpp"
+#include "SobolEngine.h"
 #include <random>
+#include <algorithm>
 
 
 //******************************************************************************************/
@@ -37,20 +38,29 @@ Decomposer::Decomposer(CCDE &_CCOptimizer,
                        double _expectedOptimum,
                        bool RG,
                        typeOfSurrogate sType,
-                       bool allocateOptimizers) : CCOptimizer(_CCOptimizer), sizeOfSubcomponents(_sizeOfSubcomponents),
+                       bool allocateOptimizers,
+                       vector<unsigned> groupSizes) : CCOptimizer(_CCOptimizer), sizeOfSubcomponents(_sizeOfSubcomponents),
     individualsPerSubcomponent(_individualsPerSubcomponent), applyRandomGrouping(RG), sType(sType)
 {
-    eng.seed(seed);
+    setSeed(seed);
     expectedOptimum = _expectedOptimum;
     bestAchievedFitness = std::numeric_limits<double>::infinity();
     coordinates = _coordinates;
+    cyclesSinceRegrouping = 0;
+    regroupingEvaluations = 0;
+    contextVectorReplaced = false;
 
-    for (unsigned i = 0; i < individualsPerSubcomponent; ++i)
-        population.push_back(_population[i]);
+    setPopulation(_population);
 
+    //groupSizes, if given, are the sizes of consecutive groups of coordinates (e.g. learned by DifferentialGrouping).
+    //The individuals of each subcomponent are initialized with its own scrambled Sobol sequence,
+    //streamed directly into the rows of the population
     unsigned d = 0, size = sizeOfSubcomponents;
     while ( d<coordinates.size() )
     {
+        if ( !groupSizes.empty() )
+            size = groupSizes[sizes.size()];
+
         if ( d + size > coordinates.size() )
             size = coordinates.size() - d;
 
@@ -59,21 +69,23 @@ Decomposer::Decomposer(CCDE &_CCOptimizer,
         baseCoordIndex.push_back(d);
         sizes.push_back(size);
 
-        int s = tau_sobol(size);
-        double *x = i8_sobol_generate(size, individualsPerSubcomponent, s);
+        SobolEngine sobol(size);
+        sobol.scramble(((uint64_t)seed << 32) | (sizes.size() - 1));
+        sobol.seek(SobolEngine::skipFor(size));
         for (int j = 0; j < individualsPerSubcomponent; j++)
         {
+            double *x = &population[j][d];
+            sobol.next(x);
             for (int k = 0; k < size; ++k)
             {
-                population[j][optCoord[k]] = CCOptimizer.lowerLimit + x[size*j + k] * (CCOptimizer.upperLimit - CCOptimizer.lowerLimit);
-                //population[j][optCoord[k]] = CCOptimizer.lowerLimit + unifRandom(eng) * (CCOptimizer.upperLimit - CCOptimizer.lowerLimit);
+                x[k] = CCOptimizer.lowerBound[optCoord[k]] + x[k] * (CCOptimizer.upperBound[optCoord[k]] - CCOptimizer.lowerBound[optCoord[k]]);
+                //x[k] = CCOptimizer.lowerBound[optCoord[k]] + unifRandom(eng) * (CCOptimizer.upperBound[optCoord[k]] - CCOptimizer.lowerBound[optCoord[k]]);
             }
         }
-        delete[] x;
 
         if (allocateOptimizers)
         {
-            JADE *optimizer = new JADE(size, individualsPerSubcomponent, *this, sType);
+            JADE *optimizer = acquireOptimizer(size, sizes.size() - 1);
             optimizer->setCoordinates(optCoord, size);
             optimizers.push_back(optimizer);
         }
@@ -83,11 +95,17 @@ Decomposer::Decomposer(CCDE &_CCOptimizer,
     numberOfSubcomponents = sizes.size();
 
     optimizers.resize(numberOfSubcomponents);
+    variableContribution.resize(CCOptimizer.problemDimension, 0.0);
+
+    //position of each variable in the rows of the population
+    vector<unsigned> position(CCOptimizer.problemDimension);
+    for (unsigned k = 0; k < coordinates.size(); ++k)
+        position[coordinates[k]] = k;
 
     contextVector.resize(CCOptimizer.problemDimension);
     _contextVector.resize(CCOptimizer.problemDimension);
     for (unsigned i = 0; i < CCOptimizer.problemDimension; ++i)
-        contextVector[i] = _contextVector[i] = population[unifRandom(eng)*population.size()][i];
+        contextVector[i] = _contextVector[i] = population[unifRandom(eng)*population.size()][position[i]];
 }
 
 
@@ -104,7 +122,7 @@ vector< JADE* >  Decomposer::allocateOptimizers(vector<unsigned> &indexes)
     for (int i = 0; i < indexes.size(); ++i)
     {
         unsigned j = indexes[i];
-        JADE *optimizer = new JADE(sizes[j], individualsPerSubcomponent, *this, sType);
+        JADE *optimizer = acquireOptimizer(sizes[j], j);
         optimizer->setCoordinates(&coordinates[baseCoordIndex[j]], sizes[j]);
         optimizers[j] = optimizer;
         bunchOfOptimizers.push_back(optimizer);
@@ -122,7 +140,7 @@ vector< JADE* >  Decomposer::allocateOptimizers(vector<unsigned> &indexes)
 //******************************************************************************************/
 JADE* Decomposer::allocateOptimizer()
 {
-    JADE *optimizer = new JADE(sizes[0], individualsPerSubcomponent, *this, sType);
+    JADE *optimizer = acquireOptimizer(sizes[0], 0);
     optimizer->setCoordinates(&coordinates[baseCoordIndex[0]], sizes[0]);
     optimizer->loadIndividuals(population);
     return optimizer;
@@ -130,6 +148,23 @@ JADE* Decomposer::allocateOptimizer()
 
 
 
+//******************************************************************************************/
+//
+// Every optimizer draws from its own stream, identified by its size and its index among the
+// subcomponents of that size: the numbers it receives do not depend on the other optimizers, on
+// the order in which they run or on the thread that runs them
+//
+//******************************************************************************************/
+JADE* Decomposer::acquireOptimizer(unsigned size, unsigned index)
+{
+    JADE *optimizer = CCOptimizer.optimizerPool->acquire(size, individualsPerSubcomponent, *this, sType);
+    optimizer->setStream(engineSeed, ((uint64_t)size << 32) | index);
+    optimizer->subcomponent = index;
+    return optimizer;
+}
+
+
+
 //******************************************************************************************/
 //
 //
@@ -169,14 +204,45 @@ void  Decomposer::setOptimizersCoordinates(vector<unsigned> &indexes)
 
 //******************************************************************************************/
 //
-//
+// _population is in the order of the variables, and is laid out in the order of coordinates
 //
 //******************************************************************************************/
 void Decomposer::setPopulation(vector< vector<double> > &_population)
 {
-    population.clear();
+    population.resize(individualsPerSubcomponent);
     for (unsigned i = 0; i < individualsPerSubcomponent; ++i)
-        population.push_back(_population[i]);
+    {
+        population[i].resize(coordinates.size());
+        for (unsigned k = 0; k < coordinates.size(); ++k)
+            population[i][k] = _population[i][coordinates[k]];
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+// Reorder the coordinates, and the rows of the population with them: the new k-th coordinate is
+// the old order[k]-th one
+//
+//******************************************************************************************/
+void Decomposer::permute(vector<unsigned> &order)
+{
+    unsigned n = coordinates.size();
+
+    permutedCoordinates.resize(n);
+    for (unsigned k = 0; k < n; ++k)
+        permutedCoordinates[k] = coordinates[order[k]];
+    coordinates.swap(permutedCoordinates);
+
+    permutedRow.resize(n);
+    for (unsigned i = 0; i < population.size(); ++i)
+    {
+        const double *row = &population[i][0];
+        for (unsigned k = 0; k < n; ++k)
+            permutedRow[k] = row[order[k]];
+        population[i].swap(permutedRow);
+    }
 }
 
 
@@ -220,7 +286,7 @@ void Decomposer::setOptimizersCoordinatesAndEvaluatePopulation()
 Decomposer::~Decomposer()
 {
     for (unsigned i = 0; i < optimizers.size(); ++i)
-        delete optimizers[i];
+        CCOptimizer.optimizerPool->release(optimizers[i]);
 };
 
 
@@ -232,6 +298,7 @@ Decomposer::~Decomposer()
 //******************************************************************************************/
 void Decomposer::setSeed(unsigned seed)
 {
+    engineSeed = seed;
     eng.seed(seed);
 }
 
@@ -239,33 +306,105 @@ void Decomposer::setSeed(unsigned seed)
 
 //******************************************************************************************/
 //
-//
+// Switch to subcomponents of the given size (a divisor of the problem dimension). The optimizers
+// of the previous size go back to the pool (see JADEPool), from which those of the new size are
+// taken, so that switching back and forth allocates nothing. The parents are loaded from the
+// population but not evaluated: the caller regroups and evaluates them.
 //
 //******************************************************************************************/
-void Decomposer::setSubcomponentsOfEqualSize(unsigned newSizeOfSubcomponents, vector<double> &fitnessValues, typeOfSurrogate sType)
+void Decomposer::setSubcomponentsOfEqualSize(unsigned newSizeOfSubcomponents)
 {
+    if (newSizeOfSubcomponents == (unsigned)sizeOfSubcomponents && optimizers.size())
+        return;
+
     for (unsigned i = 0; i < optimizers.size(); ++i)
-        delete optimizers[i];
+        CCOptimizer.optimizerPool->release(optimizers[i]);
     optimizers.clear();
 
     sizeOfSubcomponents = newSizeOfSubcomponents;
-    unsigned numberOfSubcomponents = coordinates.size() / newSizeOfSubcomponents;
+    numberOfSubcomponents = coordinates.size() / newSizeOfSubcomponents;
 
-    individualsPerSubcomponent = fitnessValues.size();
-
-    for (unsigned i = 0; i<numberOfSubcomponents; ++i)
+    for (unsigned i = 0; i < numberOfSubcomponents; ++i)
     {
-        optimizers.push_back(new JADE(sizeOfSubcomponents, individualsPerSubcomponent, *this, sType));
+        optimizers.push_back(acquireOptimizer(sizeOfSubcomponents, i));
+    }
 
+    sizes.assign(numberOfSubcomponents, sizeOfSubcomponents);
+    baseCoordIndex.resize(numberOfSubcomponents);
+    for (unsigned i = 0; i < numberOfSubcomponents; ++i)
+    {
+        baseCoordIndex[i] = i*sizeOfSubcomponents;
         optimizers[i]->setCoordinates(&(coordinates[i*sizeOfSubcomponents]), sizeOfSubcomponents);
-
         optimizers[i]->loadIndividuals(population);
-        optimizers[i]->setParendouble(fitnessValues);
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+// Exact evaluations performed so far by the optimizers currently in use
+//
+//******************************************************************************************/
+unsigned Decomposer::evaluationsOfOptimizers()
+{
+    unsigned n = 0;
+    for (unsigned j = 0; j < optimizers.size(); ++j)
+        n += optimizers[j]->nfe;
+    return n;
+}
+
 
-        //optimizers[i]->evaluateParents();
 
-        // optimizers[i]->updateIndexOfBest();
+//******************************************************************************************/
+//
+// Record the relative improvement per evaluation achieved in the last cycle by the current size
+//
+//******************************************************************************************/
+void Decomposer::updateSizePerformance(double fitnessAtCycleStart, unsigned evaluationsOfCycle)
+{
+    unsigned i = find(candidateSizes.begin(), candidateSizes.end(), (unsigned)sizeOfSubcomponents) - candidateSizes.begin();
+    if (i == candidateSizes.size())
+        return;
+
+    double improvement = 0;
+    if (isfinite(fitnessAtCycleStart) && fitnessAtCycleStart != 0 && bestAchievedFitness < fitnessAtCycleStart)
+        improvement = (fitnessAtCycleStart - bestAchievedFitness) / fabs(fitnessAtCycleStart);
+
+    sizePerformance[i] = improvement / max(1u, evaluationsOfCycle);
+}
+
+
+
+//******************************************************************************************/
+//
+// Choose the size of the next cycle as in MLCC: p_i is proportional to exp(7 r_i), where r_i is
+// the performance of size i relative to the best one. Sizes not tried yet count as the best.
+//
+//******************************************************************************************/
+unsigned Decomposer::selectSizeOfSubcomponents()
+{
+    double best = 0;
+    for (unsigned i = 0; i < sizePerformance.size(); ++i)
+        best = max(best, sizePerformance[i]);
+
+    vector<double> weight(candidateSizes.size());
+    double total = 0;
+    for (unsigned i = 0; i < candidateSizes.size(); ++i)
+    {
+        double r = (sizePerformance[i] < 0) ? 1.0 : (best > 0 ? sizePerformance[i] / best : 0.0);
+        weight[i] = exp(7.0 * r);
+        total += weight[i];
+    }
+
+    double u = unifRandom(eng) * total;
+    for (unsigned i = 0; i < candidateSizes.size(); ++i)
+    {
+        u -= weight[i];
+        if (u < 0)
+            return candidateSizes[i];
     }
+    return candidateSizes.back();
 }
 
 
@@ -289,12 +428,11 @@ void Decomposer::setCoordinates(vector<unsigned> &_coordinates)
 //******************************************************************************************/
 void Decomposer::updateContextVector(JADE *optimizer)
 {
-    vector<double> v = optimizer->getCollaborator();
-    double newBestCandidate = optimizer->calculateFitnessValue(v);
-    CCOptimizer.numberOfEvaluations++;
+    const double *v = optimizer->getCollaborator();
+    double newBestCandidate = optimizer->calculateFitnessValue(v, true, eCollaborator);
     if ( newBestCandidate < bestAchievedFitness )
     {
-        for (unsigned ld = 0; ld<v.size(); ld++)
+        for (unsigned ld = 0; ld<optimizer->coordinates.size(); ld++)
             contextVector[optimizer->coordinates[ld]] = v[ld];
 
         bestAchievedFitness = newBestCandidate;
@@ -305,39 +443,215 @@ void Decomposer::updateContextVector(JADE *optimizer)
 
 //******************************************************************************************/
 //
+// Merge the collaborators into the context vector as selected by CCDE::mergeMode.
+// The caller has already reserved reserved evaluations: they are spent first, further ones are
+// reserved only when needed, and those left over are given back. Taking over the reservation,
+// instead of releasing it and reserving again, keeps the islands that share the budget from
+// consuming the evaluations of the collaborators in between.
+//
+//******************************************************************************************/
+void Decomposer::buildContextVector(unsigned reserved)
+{
+    if (CCOptimizer.mergeMode == mGroups)
+        mergeCollaboratorsInGroups(reserved);
+    else
+        mergeCollaboratorsSequentially(reserved);
+}
+
+
+
+//******************************************************************************************/
 //
+// Each collaborator is evaluated against the context vector updated by the previous ones and
+// kept if it improves it; the context vector is then evaluated once more to confirm its fitness
 //
 //******************************************************************************************/
-void Decomposer::buildContextVector()
+void Decomposer::mergeCollaboratorsSequentially(unsigned reserved)
 {
-    for (unsigned j = 0; j<optimizers.size(); ++j)
+    EvaluationBudget &budget = CCOptimizer.budget;
+
+    mergedCandidate.resize(contextVector.size());
+    double *x = &mergedCandidate[0];
+    collaboratorImprovement.assign(optimizers.size(), 0.0);
+
+    for (unsigned j = 0; j < optimizers.size() && (reserved > 0 || budget.reserve(1)); ++j)
     {
-        optimizers[j]->nfe = 0;
-        vector<double> v = optimizers[j]->getCollaborator();
-        double newBestCandidate = optimizers[j]->calculateFitnessValue(v);
-        if ( newBestCandidate<bestAchievedFitness )
+        if (reserved > 0)
+            reserved--;
+
+        JADE *optimizer = optimizers[j];
+        const double *v = optimizer->getCollaborator();
+        optimizer->fillCandidate(v, x);
+
+        double f;
+        CCOptimizer.computeFitnessValues(x, 1, &f);
+        optimizer->nfe++;
+        budget.commit(eCollaborator, 1, optimizer->subcomponent);
+        optimizer->addElementToArchive(v, f);
+
+        if (f < bestAchievedFitness)
         {
-            for (unsigned ld = 0; ld<v.size(); ld++)
-                contextVector[optimizers[j]->coordinates[ld]] = v[ld];
-            bestAchievedFitness = newBestCandidate;
+            for (unsigned ld = 0; ld < optimizer->coordinates.size(); ld++)
+                contextVector[optimizer->coordinates[ld]] = v[ld];
+            collaboratorImprovement[j] = bestAchievedFitness - f;
+            bestAchievedFitness = f;
         }
     }
-    bestAchievedFitness = CCOptimizer.computeFitnessValue(contextVector);
-    CCOptimizer.numberOfEvaluations++;
+
+    if (reserved > 0 || budget.reserve(1))
+    {
+        if (reserved > 0)
+            reserved--;
+        bestAchievedFitness = CCOptimizer.computeFitnessValue(contextVector);
+        budget.commit(eContextVector, 1);
+    }
+
+    budget.release(reserved);
 }
 
 
 
 //******************************************************************************************/
 //
+// The collaborators of all the optimizers are evaluated against the same context vector, in a
+// single batch (one candidate per worker in parallel mode; islands, which already run on the
+// workers, use the sequential path). The improving collaborators are then merged greedily in
+// order of fitness: the best one is accepted as it is, then the others are added in groups,
+// each group being kept only if the merged vector improves. The context vector is therefore
+// always a vector whose fitness has been computed, and no confirmation is needed; the merge
+// takes at most 2*log2(number of improving collaborators) sequential evaluations, instead of
+// one per optimizer.
 //
+//******************************************************************************************/
+void Decomposer::mergeCollaboratorsInGroups(unsigned reserved)
+{
+    EvaluationBudget &budget = CCOptimizer.budget;
+
+    unsigned n = min(reserved, (unsigned)optimizers.size());
+    reserved -= n;
+    if (n < optimizers.size())
+        n += budget.reserve(optimizers.size() - n);
+
+    batchFitness.resize(n);
+    evaluateBatch(n, [this](size_t j, double *x) { optimizers[j]->fillCandidate(optimizers[j]->getCollaborator(), x); }, eCollaborator);
+
+    //each collaborator is credited with its improvement on its own, against the same context vector
+    collaboratorImprovement.assign(optimizers.size(), 0.0);
+    vector<unsigned> improving;
+    for (unsigned j = 0; j < n; ++j)
+    {
+        optimizers[j]->nfe++;
+        optimizers[j]->addElementToArchive(optimizers[j]->getCollaborator(), batchFitness[j]);
+        if (batchFitness[j] < bestAchievedFitness)
+        {
+            improving.push_back(j);
+            collaboratorImprovement[j] = bestAchievedFitness - batchFitness[j];
+        }
+    }
+
+    if (improving.empty())
+    {
+        budget.release(reserved);
+        return;
+    }
+
+    //ties are broken by the index of the optimizer, so that the merge does not depend on the evaluation order
+    stable_sort(improving.begin(), improving.end(), [this](unsigned a, unsigned b) { return batchFitness[a] < batchFitness[b]; });
+
+    JADE *best = optimizers[improving[0]];
+    const double *v = best->getCollaborator();
+    for (unsigned ld = 0; ld < best->coordinates.size(); ld++)
+        contextVector[best->coordinates[ld]] = v[ld];
+    bestAchievedFitness = batchFitness[improving[0]];
+
+    mergedCandidate.resize(contextVector.size());
+    double *x = &mergedCandidate[0];
+
+    //collaborators [next, next + group) are tried together: the group doubles when accepted and
+    //halves when rejected, and a single rejected collaborator is discarded
+    unsigned next = 1, group = 1, trials = 0;
+    unsigned maxTrials = 2 * (unsigned)ceil(log2((double)improving.size()));
+    while (next < improving.size() && trials < maxTrials && (reserved > 0 || budget.reserve(1)))
+    {
+        if (reserved > 0)
+            reserved--;
+
+        unsigned last = min(next + group, (unsigned)improving.size());
+        copy(contextVector.begin(), contextVector.end(), x);
+        for (unsigned k = next; k < last; ++k)
+        {
+            JADE *optimizer = optimizers[improving[k]];
+            const double *v = optimizer->getCollaborator();
+            for (unsigned ld = 0; ld < optimizer->coordinates.size(); ld++)
+                x[optimizer->coordinates[ld]] = v[ld];
+        }
+
+        double f;
+        CCOptimizer.computeFitnessValues(x, 1, &f);
+        budget.commit(eContextVector, 1);
+        ++trials;
+        if (f < bestAchievedFitness)
+        {
+            copy(x, x + contextVector.size(), contextVector.begin());
+            bestAchievedFitness = f;
+            next = last;
+            group *= 2;
+        }
+        else if (group > 1)
+            group /= 2;
+        else
+            ++next;
+    }
+
+    budget.release(reserved);
+}
+
+
+
+//******************************************************************************************/
+//
+// The fitness carried over by an individual is its mean fitness in the subcomponents of the
+// current grouping. It must be computed before the optimizers change (see CCDE::regroup)
+//
+//******************************************************************************************/
+void Decomposer::carryOverFitness()
+{
+    carriedOverFitness.assign(individualsPerSubcomponent, 0.0);
+    for (unsigned i = 0; i < individualsPerSubcomponent; ++i)
+    {
+        unsigned n = 0;
+        for (unsigned j = 0; j < optimizers.size(); ++j)
+            if (isfinite(optimizers[j]->parentsFitness[i]))
+            {
+                carriedOverFitness[i] += optimizers[j]->parentsFitness[i];
+                n++;
+            }
+        carriedOverFitness[i] = n ? carriedOverFitness[i] / n : std::numeric_limits<double>::infinity();
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+// Shuffle the coordinates among the optimizers, permuting the population once so that each
+// subcomponent stays contiguous (shuffling the positions draws the same permutation as shuffling
+// the coordinates). Then, depending on CCDE::regroupingMode, all the parents are evaluated, only
+// the best one of each optimizer, or none (they keep the fitness carried over, marked as stale,
+// see JADE::evaluateStaleBest)
 //
 //******************************************************************************************/
 void Decomposer::randomGrouping()
 {
+    regroupingEvaluations = 0;
     if ( optimizers.size() && this->applyRandomGrouping )
     {
-        shuffle(coordinates.begin(), coordinates.end(), eng);
+        contextVectorReplaced = false;
+
+        permutation.resize(coordinates.size());
+        iota(permutation.begin(), permutation.end(), 0);
+        shuffle(permutation.begin(), permutation.end(), eng);
+        permute(permutation);
         //setOptimizersCoordinatesAndEvaluatePopulation();
 
         unsigned numOfCoordinatesPerSubgroup = coordinates.size() / optimizers.size();
@@ -345,9 +659,295 @@ void Decomposer::randomGrouping()
         {
             optimizers[i]->setCoordinates(&(coordinates[i*numOfCoordinatesPerSubgroup]), numOfCoordinatesPerSubgroup);
             optimizers[i]->loadIndividuals(population);
-            optimizers[i]->evaluateParents();
-            CCOptimizer.numberOfEvaluations += optimizers[i]->nfe;
-            optimizers[i]->nfe = 0;
         }
+
+        if (CCOptimizer.regroupingMode == rAll)
+            regroupingEvaluations = evaluateAllParents(eRegrouping);
+        else
+        {
+            for (unsigned i = 0; i < optimizers.size(); ++i)
+                optimizers[i]->setStaleParentsFitness(carriedOverFitness);
+
+            if (CCOptimizer.regroupingMode == rBest)
+                regroupingEvaluations = evaluateBestParents();
+        }
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+// The fitness of the parents refers to the context vector they were evaluated with. After the
+// context vector has been replaced by migration, and unless a random grouping has dealt with the
+// parents since, they are treated as after a random grouping (see CCDE::regroupingMode): all of
+// them are re-evaluated, only the best one of each optimizer, or none (they are marked as stale)
+//
+//******************************************************************************************/
+void Decomposer::refreshParentsFitness()
+{
+    if (!contextVectorReplaced)
+        return;
+    contextVectorReplaced = false;
+
+    if (CCOptimizer.regroupingMode == rAll)
+    {
+        evaluateAllParents(eRegrouping);
+        return;
+    }
+
+    for (unsigned i = 0; i < optimizers.size(); ++i)
+        optimizers[i]->markParentsStale();
+
+    if (CCOptimizer.regroupingMode == rBest)
+        evaluateBestParents();
+}
+
+
+
+//******************************************************************************************/
+//
+// Assign the generations of the next cycle. With uniform allocation every optimizer gets
+// numItePerCycle generations. With contribution-based allocation (in the style of CBCC) the
+// same total is shared as follows: a part of it equally, so that every contribution can still be
+// measured, and the fraction CCDE::contributionShare in proportion to the contribution of the
+// variables of each optimizer. Contributions are kept per variable because random grouping
+// changes the subcomponents at every cycle.
+//
+//******************************************************************************************/
+void Decomposer::allocateGenerations(unsigned numItePerCycle)
+{
+    unsigned m = optimizers.size();
+
+    generations.assign(m, numItePerCycle);
+
+    if (CCOptimizer.allocationMode != aContribution || numItePerCycle <= 1)
+        return;
+
+    vector<double> score(m, 0.0);
+    double totalScore = 0;
+    for (unsigned j = 0; j < m; ++j)
+    {
+        for (unsigned ld = 0; ld < optimizers[j]->coordinates.size(); ++ld)
+            score[j] += variableContribution[optimizers[j]->coordinates[ld]];
+        totalScore += score[j];
+    }
+
+    //no improvement measured yet
+    if (!(totalScore > 0) || !isfinite(totalScore))
+        return;
+
+    //largest remainder rounding of the proportional shares
+    unsigned equalShare = numItePerCycle - (unsigned)(CCOptimizer.contributionShare * numItePerCycle + 0.5);
+    unsigned spare = m * (numItePerCycle - equalShare);
+    unsigned assigned = 0;
+    vector<double> remainder(m);
+    for (unsigned j = 0; j < m; ++j)
+    {
+        double share = spare * score[j] / totalScore;
+        unsigned q = (unsigned)share;
+        generations[j] = equalShare + q;
+        remainder[j] = share - q;
+        assigned += q;
+    }
+
+    vector<unsigned> order(m);
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&remainder](unsigned a, unsigned b) { return remainder[a] > remainder[b]; });
+    for (unsigned k = 0; k < spare - assigned && k < m; ++k)
+        generations[order[k]]++;
+}
+
+
+
+//******************************************************************************************/
+//
+// Credit the improvement per generation brought by each optimizer in the last cycle to its
+// variables, averaging with the previous contributions as in CBCC. As in CBCC, the improvement
+// is that of the fitness of the context vector when the collaborator is merged: the best fitness
+// of the optimizer itself cannot serve, as its parents were evaluated against the context vector
+// of a previous cycle, which the other optimizers have improved since
+//
+//******************************************************************************************/
+void Decomposer::updateContributions()
+{
+    if (CCOptimizer.allocationMode != aContribution)
+        return;
+
+    for (unsigned j = 0; j < optimizers.size(); ++j)
+    {
+        double delta = j < collaboratorImprovement.size() ? collaboratorImprovement[j] : 0;
+        if (!isfinite(delta) || delta < 0 || generations[j] == 0)
+            delta = 0;
+        else
+            delta /= generations[j];
+
+        unsigned size = optimizers[j]->coordinates.size();
+        double share = delta / size;
+        for (unsigned ld = 0; ld < size; ++ld)
+        {
+            double &c = variableContribution[optimizers[j]->coordinates[ld]];
+            c = (c + share) / 2;
+        }
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+// Grouping, population, context vector, generator and contributions, followed by the state of
+// every optimizer
+//
+//******************************************************************************************/
+void Decomposer::saveState(CheckpointWriter &w)
+{
+    w.put(sizeOfSubcomponents);
+    w.putVector(sizePerformance);
+    w.put(cyclesSinceRegrouping);
+    w.put(regroupingEvaluations);
+    w.put(contextVectorReplaced);
+    w.put((uint64_t)optimizers.size());
+    w.putVector(coordinates);
+    w.put((uint64_t)population.size());
+    for (unsigned i = 0; i < population.size(); ++i)
+        w.putVector(population[i]);
+    w.putVector(contextVector);
+    w.put(bestAchievedFitness);
+    w.putEngine(eng);
+    w.putVector(generations);
+    w.putVector(variableContribution);
+
+    for (unsigned j = 0; j < optimizers.size(); ++j)
+        optimizers[j]->saveState(w);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void Decomposer::loadState(CheckpointReader &r)
+{
+    uint64_t n;
+    int size;
+
+    r.get(size);
+    setSubcomponentsOfEqualSize(size);
+    r.getVector(sizePerformance);
+    r.get(cyclesSinceRegrouping);
+    r.get(regroupingEvaluations);
+    r.get(contextVectorReplaced);
+
+    r.get(n);
+    if (n != optimizers.size())
+    {
+        cerr << "the checkpoint was saved with a different decomposition" << endl;
+        exit(1);
+    }
+
+    r.getVector(coordinates);
+    r.get(n);
+    population.resize((size_t)n);
+    for (unsigned i = 0; i < population.size(); ++i)
+        r.getVector(population[i]);
+    r.getVector(contextVector);
+    r.get(bestAchievedFitness);
+    r.getEngine(eng);
+    r.getVector(generations);
+    r.getVector(variableContribution);
+
+    for (unsigned j = 0; j < optimizers.size(); ++j)
+        optimizers[j]->loadState(r);
+}
+
+
+
+//******************************************************************************************/
+//
+// Evaluate the parents of every optimizer against the current context vector. Sequentially,
+// all the candidates are submitted to the objective function in batches as large as
+// CCDE::evaluateCandidates allows; in parallel mode each worker evaluates the parents of one
+// optimizer. Islands, which already run on the workers, use the sequential path.
+//
+//******************************************************************************************/
+unsigned Decomposer::evaluateAllParents(typeOfEvaluation type)
+{
+    if (CCOptimizer.pool && ThreadPool::workerIndex() < 0)
+    {
+        vector<unsigned> granted(optimizers.size());
+        CCOptimizer.pool->parallelFor(optimizers.size(), [this, type, &granted](unsigned i) { granted[i] = optimizers[i]->evaluateParents(type); });
+        return accumulate(granted.begin(), granted.end(), 0u);
+    }
+
+    vector<unsigned> granted(optimizers.size());
+    unsigned n = 0;
+    for (unsigned i = 0; i < optimizers.size(); ++i)
+    {
+        granted[i] = CCOptimizer.budget.reserve(optimizers[i]->numberOfParents);
+        n += granted[i];
+    }
+
+    batchFitness.resize(n);
+
+    //the rows are filled in order: parent k of optimizer i
+    unsigned i = 0, k = 0;
+    CCOptimizer.evaluateCandidates(n, [this, &granted, &i, &k](size_t, double *x)
+    {
+        while (k == granted[i])
+        {
+            i++;
+            k = 0;
+        }
+        optimizers[i]->fillCandidate(optimizers[i]->parent(k++), x);
+    }, batchFitness.data(), false);
+
+    unsigned row = 0;
+    for (unsigned i = 0; i < optimizers.size(); ++i)
+    {
+        CCOptimizer.budget.commit(type, granted[i], optimizers[i]->subcomponent);
+        optimizers[i]->setParentsFitness(&batchFitness[row], granted[i]);
+        row += granted[i];
     }
+
+    return n;
+}
+
+
+
+//******************************************************************************************/
+//
+// After a regrouping without re-evaluation, evaluate only the best parent of each optimizer
+// according to the fitness carried over, so that every optimizer starts from a true fitness
+//
+//******************************************************************************************/
+unsigned Decomposer::evaluateBestParents()
+{
+    unsigned n = CCOptimizer.budget.reserve(optimizers.size());
+
+    batchFitness.resize(n);
+    evaluateBatch(n, [this](size_t j, double *x) { optimizers[j]->fillCandidate(optimizers[j]->parent(optimizers[j]->indexOfBest), x); }, eRegrouping);
+
+    for (unsigned j = 0; j < n; ++j)
+        optimizers[j]->setParentFitness(optimizers[j]->indexOfBest, batchFitness[j]);
+
+    return n;
+}
+
+
+
+//******************************************************************************************/
+//
+// Evaluate n candidates, whose evaluations have been reserved, into batchFitness: one candidate
+// per worker in parallel mode, otherwise in batches (see CCDE::evaluateCandidates). Candidate j
+// is spent by optimizer j
+//
+//******************************************************************************************/
+void Decomposer::evaluateBatch(unsigned n, const function<void(size_t, double*)> &fill, typeOfEvaluation type)
+{
+    CCOptimizer.evaluateCandidates(n, fill, batchFitness.data(), CCOptimizer.pool && ThreadPool::workerIndex() < 0);
+    for (unsigned j = 0; j < n; ++j)
+        CCOptimizer.budget.commit(type, 1, optimizers[j]->subcomponent);
 }
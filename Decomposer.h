@@ -28,8 +28,6 @@ class CCDE;
 
 using namespace std;
 
-typedef mt19937 RandomEngine;
-
 class Decomposer
 {
 public:
@@ -40,11 +38,15 @@ public:
     bool applyRandomGrouping;
     double bestAchievedFitness;
     RandomEngine eng;
+    ///seed of eng (stream 0) and of the streams of the optimizers
+    unsigned engineSeed;
     uniform_real_distribution<double> unifRandom;
     unsigned individualsPerSubcomponent;
     unsigned numberOfSubcomponents;
 
-    //Current population
+    //Current population; each row is laid out in the order of coordinates, so that the variables
+    //of every subcomponent are contiguous (see JADE::blockStart). With the parents and offspring of
+    //the optimizers, it is most of the memory of the optimizer (see the memory model of CCDE)
     vector< vector<double> > population;
 
     //Final global best position and context vector
@@ -60,6 +62,40 @@ public:
     vector<unsigned> sizes;
     vector<unsigned> baseCoordIndex;
 
+    //Fitness of the candidates of all the optimizers evaluated together, and the context vector being
+    //merged from the collaborators (see buildContextVector)
+    vector<double> batchFitness;
+    vector<double> mergedCandidate;
+
+    //Generations assigned to each optimizer in the current cycle, and improvement of the fitness of the
+    //context vector brought by its collaborator in the last merge (see buildContextVector)
+    vector<unsigned> generations;
+    vector<double> collaboratorImprovement;
+
+    //Fitness improvement per generation credited to each variable, averaged over the cycles (contribution-based allocation)
+    vector<double> variableContribution;
+
+    //Adaptive size of the subcomponents (MLCC): candidate sizes, and improvement per evaluation last
+    //achieved with each of them (negative -> not tried yet)
+    vector<unsigned> candidateSizes;
+    vector<double> sizePerformance;
+
+    //Cycles since the last random grouping, and true evaluations spent by it (see CCDE::setRegroupingMode)
+    unsigned cyclesSinceRegrouping;
+    unsigned regroupingEvaluations;
+
+    //Fitness of each individual carried over to the next grouping when the parents are not re-evaluated
+    vector<double> carriedOverFitness;
+
+    //The context vector has been replaced by migration since the parents were last evaluated
+    //(see refreshParentsFitness)
+    bool contextVectorReplaced;
+
+    //Buffers of the permutation applied by random grouping
+    vector<unsigned> permutation;
+    vector<unsigned> permutedCoordinates;
+    vector<double> permutedRow;
+
     Decomposer(CCDE &_CCOptimizer, unsigned seed, vector<unsigned> &_coordinates,
                unsigned _sizeOfSubcomponents,
                unsigned _individualsPerSubcomponent,
@@ -67,18 +103,35 @@ public:
                vector<double>  &_contextVector,
                double _expectedOptimum,
                bool RG,
-               typeOfSurrogate sType, bool allocateOptimizers=true);
+               typeOfSurrogate sType, bool allocateOptimizers=true,
+               vector<unsigned> groupSizes=vector<unsigned>());
     ~Decomposer();
     vector< JADE* >  allocateOptimizers(vector<unsigned> &indexes);
     JADE*  allocateOptimizer();
+    JADE*  acquireOptimizer(unsigned size, unsigned index);
     void setPopulation(vector< vector<double> > &_population);
-    void setSubcomponentsOfEqualSize(unsigned newSizeOfSubcomponents, vector<double> &fitnessValues, typeOfSurrogate sType);
+    void permute(vector<unsigned> &order);
+    void setSubcomponentsOfEqualSize(unsigned newSizeOfSubcomponents);
+    void updateSizePerformance(double fitnessAtCycleStart, unsigned evaluationsOfCycle);
+    unsigned selectSizeOfSubcomponents();
+    unsigned evaluationsOfOptimizers();
     void setCoordinates(vector<unsigned> &_coordinates);
     void updateContextVector(JADE *optimizer);
-    void buildContextVector();
+    void buildContextVector(unsigned reserved);
+    void mergeCollaboratorsSequentially(unsigned reserved);
+    void mergeCollaboratorsInGroups(unsigned reserved);
+    void carryOverFitness();
     void randomGrouping();
+    void refreshParentsFitness();
+    unsigned evaluateAllParents(typeOfEvaluation type = eParents);
+    unsigned evaluateBestParents();
+    void evaluateBatch(unsigned n, const function<void(size_t, double*)> &fill, typeOfEvaluation type);
+    void allocateGenerations(unsigned numItePerCycle);
+    void updateContributions();
     void setSeed(unsigned seed);
     void setOptimizersCoordinatesAndEvaluatePopulation();
     void setOptimizersCoordinatesAndEvaluatePopulation(vector<unsigned> &indexes);
     void setOptimizersCoordinates(vector<unsigned> &indexes);
+    void saveState(CheckpointWriter &w);
+    void loadState(CheckpointReader &r);
 };
@@ -0,0 +1,349 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : DifferentialGrouping.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "DifferentialGrouping.h"
+#include "CCDE.h"
+#include "Checkpoint.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+DifferentialGrouping::DifferentialGrouping(CCDE &_CCOptimizer) : CCOptimizer(_CCOptimizer)
+{
+    n = CCOptimizer.problemDimension;
+    baseFitness = numeric_limits<double>::quiet_NaN();
+    singleFitness.assign(n, numeric_limits<double>::quiet_NaN());
+    completedRows = 0;
+    rowFitness.assign(n > 0 ? n - 1 : 0, numeric_limits<double>::quiet_NaN());
+    parent.resize(n);
+    for (unsigned i = 0; i < n; ++i)
+        parent[i] = i;
+    eta0 = 0;
+    eta1 = 0;
+    reusedEvaluations = 0;
+    performedEvaluations = 0;
+}
+
+
+
+//******************************************************************************************/
+//
+// x1 with the variables i and j (if not negative) moved to the centre of the domain
+//
+//******************************************************************************************/
+void DifferentialGrouping::fillPoint(double *x, int i, int j) const
+{
+    copy(CCOptimizer.lowerBound.begin(), CCOptimizer.lowerBound.end(), x);
+
+    if (i >= 0)
+        x[i] = (CCOptimizer.lowerBound[i] + CCOptimizer.upperBound[i]) / 2;
+    if (j >= 0)
+        x[j] = (CCOptimizer.lowerBound[j] + CCOptimizer.upperBound[j]) / 2;
+}
+
+
+
+//******************************************************************************************/
+//
+// The tests are evaluated in batches, first x1 and the points with a single moved variable,
+// then the pairs row by row; each row is classified as soon as it is complete, and its fitness
+// values are dropped
+//
+//******************************************************************************************/
+void DifferentialGrouping::learn(unsigned maxEvaluations)
+{
+    EvaluationBudget &budget = CCOptimizer.budget;
+    unsigned available = maxEvaluations ? maxEvaluations : numeric_limits<unsigned>::max();
+
+    vector<double> batchFitness;
+    vector<int> rows;
+
+    //x1 and the single moves
+    rows.clear();
+    if (std::isnan(baseFitness))
+        rows.push_back(-1);
+    for (unsigned i = 0; i < n; ++i)
+        if (std::isnan(singleFitness[i]))
+            rows.push_back(i);
+
+    unsigned k = budget.reserve(min(available, (unsigned)rows.size()));
+    batchFitness.resize(k);
+    CCOptimizer.evaluateCandidates(k, [this, &rows](size_t r, double *x) { fillPoint(x, rows[r], -1); }, batchFitness.data(), false);
+    budget.commit(eGrouping, k);
+
+    for (unsigned r = 0; r < k; ++r)
+    {
+        if (rows[r] < 0)
+            baseFitness = batchFitness[r];
+        else
+            singleFitness[rows[r]] = batchFitness[r];
+    }
+    available -= k;
+    performedEvaluations += k;
+
+    if (k < rows.size())
+        return;
+
+    //the pairs
+    while (completedRows + 1 < n && available > 0)
+    {
+        unsigned i = completedRows;
+
+        rows.clear();
+        for (unsigned j = i + 1; j < n; ++j)
+            if (std::isnan(rowFitness[j - i - 1]))
+                rows.push_back(j);
+
+        k = budget.reserve(min(available, (unsigned)rows.size()));
+        batchFitness.resize(k);
+        CCOptimizer.evaluateCandidates(k, [this, i, &rows](size_t r, double *x) { fillPoint(x, i, rows[r]); }, batchFitness.data(), false);
+        budget.commit(eGrouping, k);
+
+        for (unsigned r = 0; r < k; ++r)
+            rowFitness[rows[r] - i - 1] = batchFitness[r];
+        available -= k;
+        performedEvaluations += k;
+
+        if (k < rows.size())
+            return;
+
+        classifyRow(i, parent, eta0, eta1, undecidedPairs, undecidedTests);
+        completedRows++;
+        rowFitness.assign(n - completedRows - 1, numeric_limits<double>::quiet_NaN());
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+// Difference between the effects of moving x_i with x_j in its two positions, and the bounds of
+// the rounding errors of this difference (DG2)
+//
+//******************************************************************************************/
+void DifferentialGrouping::test(unsigned i, unsigned j, double pairFitness, double &lambda, double &lowerThreshold, double &upperThreshold) const
+{
+    const double muM = numeric_limits<double>::epsilon() / 2;
+    auto gamma = [muM](double k) { return k * muM / (1 - k * muM); };
+
+    double f1 = baseFitness;
+    double f2 = singleFitness[i];
+    double f3 = singleFitness[j];
+    double f4 = pairFitness;
+
+    lambda = fabs((f2 - f1) - (f4 - f3));
+    lowerThreshold = gamma(2) * max(fabs(f2 + f3), fabs(f4 + f1));
+    upperThreshold = gamma(sqrt((double)n)) * max(max(fabs(f1), fabs(f2)), max(fabs(f3), fabs(f4)));
+}
+
+
+
+//******************************************************************************************/
+//
+// Representative of the group of variable i, halving the path to it
+//
+//******************************************************************************************/
+unsigned DifferentialGrouping::root(vector<unsigned> &forest, unsigned i)
+{
+    while (forest[i] != i)
+        i = forest[i] = forest[forest[i]];
+    return i;
+}
+
+
+
+//******************************************************************************************/
+//
+// Classify the evaluated pairs of row i, held in rowFitness: a pair is separable below the lower
+// threshold and interacting above the upper one, in which case its variables are joined in the
+// forest; the pairs in between are kept for groups
+//
+//******************************************************************************************/
+void DifferentialGrouping::classifyRow(unsigned i, vector<unsigned> &forest, unsigned &n0, unsigned &n1, vector<unsigned> &pairs, vector<double> &tests) const
+{
+    double lambda, lowerThreshold, upperThreshold;
+
+    for (unsigned j = i + 1; j < n; ++j)
+    {
+        double f = rowFitness[j - i - 1];
+        if (std::isnan(f))
+            continue;
+
+        test(i, j, f, lambda, lowerThreshold, upperThreshold);
+        if (lambda < lowerThreshold)
+            n0++;
+        else if (lambda > upperThreshold)
+        {
+            n1++;
+            forest[root(forest, i)] = root(forest, j);
+        }
+        else
+        {
+            pairs.push_back(i);
+            pairs.push_back(j);
+            tests.push_back(lambda);
+            tests.push_back(lowerThreshold);
+            tests.push_back(upperThreshold);
+        }
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+// The pairs left undecided by the thresholds are decided with their weighted mean, weighted by
+// the number of pairs decided by each of them (DG2). The row in progress, if any, is classified
+// together with the completed ones. The interacting variables are then grouped by union-find
+//
+//******************************************************************************************/
+vector< vector<unsigned> > DifferentialGrouping::groups()
+{
+    vector<unsigned> forest = parent;
+    unsigned n0 = eta0, n1 = eta1;
+    vector<unsigned> pairs = undecidedPairs;
+    vector<double> tests = undecidedTests;
+
+    if (completedRows + 1 < n)
+        classifyRow(completedRows, forest, n0, n1, pairs, tests);
+
+    for (size_t p = 0; p < pairs.size() / 2; ++p)
+    {
+        double lambda = tests[3 * p];
+        double lowerThreshold = tests[3 * p + 1];
+        double upperThreshold = tests[3 * p + 2];
+
+        bool interacting;
+        if (n0 + n1 == 0)
+            interacting = lambda > (lowerThreshold + upperThreshold) / 2;
+        else
+            interacting = lambda > (n0 * lowerThreshold + n1 * upperThreshold) / (n0 + n1);
+
+        if (interacting)
+            forest[root(forest, pairs[2 * p])] = root(forest, pairs[2 * p + 1]);
+    }
+
+    //components in order of their first variable
+    vector< vector<unsigned> > components;
+    vector<int> componentOf(n, -1);
+    for (unsigned i = 0; i < n; ++i)
+    {
+        unsigned r = root(forest, i);
+        if (componentOf[r] < 0)
+        {
+            componentOf[r] = components.size();
+            components.push_back(vector<unsigned>());
+        }
+        components[componentOf[r]].push_back(i);
+    }
+
+    vector< vector<unsigned> > result;
+    vector<unsigned> separable;
+    for (unsigned c = 0; c < components.size(); ++c)
+    {
+        if (components[c].size() == 1)
+            separable.push_back(components[c][0]);
+        else
+            result.push_back(components[c]);
+    }
+    result.push_back(separable);
+
+    return result;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+bool DifferentialGrouping::loadCache(const string &file)
+{
+    CheckpointReader r;
+    if (!r.load(file))
+        return false;
+
+    string header;
+    unsigned id, dimension;
+    vector<double> lowerBound, upperBound;
+
+    r.getString(header);
+    if (header != "SACCJADE differential grouping v3")
+        return false;
+    r.get(id);
+    r.get(dimension);
+    r.getVector(lowerBound);
+    r.getVector(upperBound);
+    if (id != CCOptimizer.getFitness()->getID() || dimension != n ||
+        lowerBound != CCOptimizer.lowerBound || upperBound != CCOptimizer.upperBound)
+        return false;
+
+    r.get(baseFitness);
+    r.getVector(singleFitness);
+    r.get(completedRows);
+    r.getVector(rowFitness);
+    r.getVector(parent);
+    r.get(eta0);
+    r.get(eta1);
+    r.getVector(undecidedPairs);
+    r.getVector(undecidedTests);
+
+    reusedEvaluations = !std::isnan(baseFitness);
+    for (unsigned i = 0; i < singleFitness.size(); ++i)
+        reusedEvaluations += !std::isnan(singleFitness[i]);
+    reusedEvaluations += (unsigned)((size_t)completedRows * (2 * n - completedRows - 1) / 2);
+    for (unsigned j = 0; j < rowFitness.size(); ++j)
+        reusedEvaluations += !std::isnan(rowFitness[j]);
+
+    return true;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void DifferentialGrouping::saveCache(const string &file)
+{
+    CheckpointWriter w;
+    w.putString("SACCJADE differential grouping v3");
+    w.put(CCOptimizer.getFitness()->getID());
+    w.put(n);
+    w.putVector(CCOptimizer.lowerBound);
+    w.putVector(CCOptimizer.upperBound);
+    w.put(baseFitness);
+    w.putVector(singleFitness);
+    w.put(completedRows);
+    w.putVector(rowFitness);
+    w.putVector(parent);
+    w.put(eta0);
+    w.put(eta1);
+    w.putVector(undecidedPairs);
+    w.putVector(undecidedTests);
+
+    CheckpointFile output;
+    output.write(file, w);
+    output.wait();
+}
@@ -0,0 +1,89 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : DifferentialGrouping.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <vector>
+#include <string>
+
+class CCDE;
+
+using namespace std;
+
+
+/**
+	@brief Decomposition learned from the interactions between variables, in the style of DG2
+	(Omidvar et al., 'DG2: A Faster and More Accurate Differential Grouping for Large-Scale
+	Black-Box Optimization', IEEE TEVC 2017).
+
+	Variables i and j interact if moving x_i changes the objective by a different amount depending
+	on x_j. All the tests start from the lower bound x1 and move variables to the centre of the
+	domain, so that f(x1) and the n points with a single moved variable are shared by all the
+	pairs: a complete interaction matrix takes 1 + n + n(n-1)/2 evaluations. The threshold of each
+	test is derived from the bounds of the rounding errors of its four fitness values.
+
+	The evaluations are drawn from CCDE::budget (eGrouping) up to a given number; the pairs not
+	tested when that number is reached are assumed not to interact. The pairs are tested row by row
+	(i, i+1..n-1), and only the fitness values of the row in progress are kept: each complete row is
+	reduced to the unions of the interacting variables and to the tests left undecided between the
+	two thresholds, which are resolved at the end. The memory is therefore O(n) plus the undecided
+	tests, instead of the n(n-1)/2 fitness values of the whole matrix. The state of the learning can
+	be saved to a cache file: a later run on the same function reuses it and only evaluates the
+	pairs still missing.
+*/
+class DifferentialGrouping
+{
+    CCDE &CCOptimizer;
+    unsigned n;
+
+    ///f(x1) and f(x1 with x_i moved) (NaN -> not evaluated)
+    double baseFitness;
+    vector<double> singleFitness;
+
+    ///rows of pairs completed, and f(x1 with x_i and x_j moved) for i = completedRows and the j > i
+    ///of the row in progress (NaN -> not evaluated)
+    unsigned completedRows;
+    vector<double> rowFitness;
+
+    ///outcome of the tests of the completed rows: union-find forest of the interacting variables,
+    ///tests decided by the lower and by the upper threshold, and the undecided ones, as pairs (i, j)
+    ///and triples (lambda, lower threshold, upper threshold)
+    vector<unsigned> parent;
+    unsigned eta0, eta1;
+    vector<unsigned> undecidedPairs;
+    vector<double> undecidedTests;
+
+    void test(unsigned i, unsigned j, double pairFitness, double &lambda, double &lowerThreshold, double &upperThreshold) const;
+    static unsigned root(vector<unsigned> &forest, unsigned i);
+    void classifyRow(unsigned i, vector<unsigned> &forest, unsigned &n0, unsigned &n1, vector<unsigned> &pairs, vector<double> &tests) const;
+    void fillPoint(double *x, int i, int j) const;
+
+public:
+    ///Evaluations taken from the cache file and performed in this run
+    unsigned reusedEvaluations;
+    unsigned performedEvaluations;
+
+    DifferentialGrouping(CCDE &_CCOptimizer);
+
+    ///Evaluate the missing tests, performing at most maxEvaluations evaluations (0 -> all of them)
+    void learn(unsigned maxEvaluations);
+
+    ///Groups of interacting variables, followed by the group of the separable ones (the layout of
+    ///Fitness::idealGroups)
+    vector< vector<unsigned> > groups();
+
+    ///The cache is used only if it was saved for the same function, dimension and bounds
+    bool loadCache(const string &file);
+    void saveCache(const string &file);
+};
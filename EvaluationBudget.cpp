@@ -0,0 +1,206 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : EvaluationBudget.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "EvaluationBudget.h"
+#include <climits>
+
+using namespace std;
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+EvaluationBudget::EvaluationBudget()
+{
+    reset(0);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void EvaluationBudget::reset(unsigned _maxNumberOfEvaluations)
+{
+    maxNumberOfEvaluations = _maxNumberOfEvaluations;
+    claimed = 0;
+    used = 0;
+    for (unsigned i = 0; i < numOfEvaluationTypes; ++i)
+        usedByType[i] = 0;
+    trackSubcomponents(0);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void EvaluationBudget::trackSubcomponents(unsigned n)
+{
+    numOfSubcomponents = n;
+    usedBySubcomponent.reset(new atomic<unsigned>[n]);
+    for (unsigned j = 0; j < n; ++j)
+        usedBySubcomponent[j] = 0;
+    usedByUntracked = 0;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+unsigned EvaluationBudget::reserve(unsigned n)
+{
+    unsigned current = claimed.load();
+    unsigned granted;
+    do
+    {
+        if (current >= maxNumberOfEvaluations)
+            return 0;
+        granted = min(n, maxNumberOfEvaluations - current);
+    } while (!claimed.compare_exchange_weak(current, current + granted));
+
+    return granted;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void EvaluationBudget::commit(typeOfEvaluation type, unsigned n, int subcomponent)
+{
+    used += n;
+    usedByType[type] += n;
+
+    if (subcomponent >= (int)numOfSubcomponents)
+        usedByUntracked += n;
+    else if (subcomponent != noSubcomponent)
+        usedBySubcomponent[subcomponent] += n;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void EvaluationBudget::release(unsigned n)
+{
+    claimed -= n;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void EvaluationBudget::restore(const unsigned *_usedByType, const vector<unsigned> &_usedBySubcomponent)
+{
+    unsigned total = 0;
+    for (unsigned i = 0; i < numOfEvaluationTypes; ++i)
+    {
+        usedByType[i] = _usedByType[i];
+        total += _usedByType[i];
+    }
+    used = total;
+    claimed = total;
+
+    trackSubcomponents(_usedBySubcomponent.empty() ? 0 : _usedBySubcomponent.size() - 1);
+    for (unsigned j = 0; j < numOfSubcomponents; ++j)
+        usedBySubcomponent[j] = _usedBySubcomponent[j];
+    if (!_usedBySubcomponent.empty())
+        usedByUntracked = _usedBySubcomponent.back();
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+vector<unsigned> EvaluationBudget::getUsedBySubcomponent() const
+{
+    vector<unsigned> n(numOfSubcomponents + 1);
+    for (unsigned j = 0; j < numOfSubcomponents; ++j)
+        n[j] = usedBySubcomponent[j].load();
+    n[numOfSubcomponents] = usedByUntracked.load();
+    return n;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+unsigned EvaluationBudget::getAvailable() const
+{
+    unsigned current = claimed.load();
+    return current >= maxNumberOfEvaluations ? 0 : maxNumberOfEvaluations - current;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void EvaluationBudget::printBreakdown(ostream &os) const
+{
+    os << "Evaluations: initialization=" << getUsed(eInitialization)
+       << "  parents=" << getUsed(eParents)
+       << "  offspring=" << getUsed(eOffspring)
+       << "  surrogate=" << getUsed(eSurrogate)
+       << "  collaborators=" << getUsed(eCollaborator)
+       << "  context vector=" << getUsed(eContextVector)
+       << "  regrouping=" << getUsed(eRegrouping)
+       << "  grouping=" << getUsed(eGrouping)
+       << "  total=" << getUsed() << "/" << maxNumberOfEvaluations << endl;
+
+    if (numOfSubcomponents == 0)
+        return;
+
+    //the evaluations of the context vector and of the grouping belong to no subcomponent
+    unsigned lowest = UINT_MAX, highest = 0, total = 0;
+    for (unsigned j = 0; j < numOfSubcomponents; ++j)
+    {
+        unsigned n = usedBySubcomponent[j].load();
+        lowest = min(lowest, n);
+        highest = max(highest, n);
+        total += n;
+    }
+    os << "Evaluations per subcomponent: min=" << lowest << "  max=" << highest
+       << "  total=" << total << "  subcomponents=" << numOfSubcomponents << endl;
+    os << "  ";
+    for (unsigned j = 0; j < numOfSubcomponents; ++j)
+        os << j << ":" << usedBySubcomponent[j].load() << ((j + 1) % 10 ? "  " : "\n  ");
+    os << "untracked=" << usedByUntracked.load() << endl;
+}
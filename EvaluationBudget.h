@@ -0,0 +1,97 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : EvaluationBudget.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <atomic>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+///Purpose of a true fitness evaluation, used for the breakdown of the budget
+///(eRegrouping: parents evaluated because the random grouping changed their subcomponent, or
+///migration their context vector;
+///eGrouping: evaluations spent to learn the interactions between variables)
+typedef enum { eInitialization = 0, eParents, eOffspring, eSurrogate, eCollaborator, eContextVector, eRegrouping, eGrouping, numOfEvaluationTypes } typeOfEvaluation;
+
+
+/**
+	@brief Budget of exact fitness evaluations shared by all the components of the optimizer.
+	Evaluations are first reserved, which never lets the total exceed the allowed number even when
+	several threads draw from the budget, and then committed with their purpose and, when they
+	belong to one, with the subcomponent that spent them.
+	All the counters are lock-free.
+*/
+class EvaluationBudget
+{
+    unsigned maxNumberOfEvaluations;
+
+    ///committed evaluations plus outstanding reservations
+    atomic<unsigned> claimed;
+
+    atomic<unsigned> used;
+    atomic<unsigned> usedByType[numOfEvaluationTypes];
+
+    ///evaluations committed by each subcomponent, indexed by its position in the decomposer
+    ///(summed over the islands), and by the subcomponents beyond the tracked ones
+    unique_ptr< atomic<unsigned>[] > usedBySubcomponent;
+    unsigned numOfSubcomponents;
+    atomic<unsigned> usedByUntracked;
+
+public:
+    ///Subcomponent of the evaluations that do not belong to a single one (e.g. the context vector)
+    static const int noSubcomponent = -1;
+
+    EvaluationBudget();
+
+    ///Set the allowed number of evaluations and clear all the counters
+    void reset(unsigned _maxNumberOfEvaluations);
+
+    ///Keep a counter for each of the subcomponents 0..n-1 and clear them; n must be the largest
+    ///number of subcomponents of the run, as it cannot change while evaluations are committed
+    void trackSubcomponents(unsigned n);
+
+    ///Reserve up to n evaluations; returns the number actually granted
+    unsigned reserve(unsigned n);
+
+    ///Record n evaluations, previously reserved, as performed by the given subcomponent
+    void commit(typeOfEvaluation type, unsigned n, int subcomponent = noSubcomponent);
+
+    ///Give back n reserved evaluations that were not performed
+    void release(unsigned n);
+
+    ///Set the evaluations performed for each purpose and by each subcomponent, when resuming from a
+    ///checkpoint; there must be no outstanding reservations
+    void restore(const unsigned *_usedByType, const vector<unsigned> &_usedBySubcomponent);
+
+    ///Performed evaluations
+    unsigned getUsed() const { return used.load(); }
+    unsigned getUsed(typeOfEvaluation type) const { return usedByType[type].load(); }
+
+    ///Evaluations performed by each tracked subcomponent, followed by those of the untracked ones
+    vector<unsigned> getUsedBySubcomponent() const;
+
+    ///Evaluations that can still be reserved
+    unsigned getAvailable() const;
+
+    unsigned getMax() const { return maxNumberOfEvaluations; }
+
+    bool exhausted() const { return getAvailable() == 0; }
+
+    ///Print the number of evaluations spent for each purpose and by each subcomponent
+    void printBreakdown(ostream &os) const;
+};
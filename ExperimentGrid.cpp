@@ -0,0 +1,414 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : ExperimentGrid.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "ExperimentGrid.h"
+#include "CCDE.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <map>
+#include <chrono>
+#include <cstdio>
+
+using namespace std;
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+static string trim(const string &s)
+{
+    size_t first = s.find_first_not_of(" \t\r\n");
+    if (first == string::npos)
+        return "";
+    size_t last = s.find_last_not_of(" \t\r\n");
+    return s.substr(first, last - first + 1);
+}
+
+
+
+//******************************************************************************************/
+//
+// Parse a comma-separated list of numbers and ranges (e.g. "1-3,7" -> 1,2,3,7)
+//
+//******************************************************************************************/
+static bool parseValues(const string &s, vector<unsigned> &values)
+{
+    values.clear();
+    stringstream items(s);
+    string item;
+    while (getline(items, item, ','))
+    {
+        item = trim(item);
+        unsigned first, last;
+        char dash;
+        stringstream is(item);
+        if (!(is >> first))
+            return false;
+        last = first;
+        if (is >> dash)
+        {
+            if (dash != '-' || !(is >> last) || last < first)
+                return false;
+        }
+        if (!(is >> ws).eof())
+            return false;
+        for (unsigned v = first; v <= last; ++v)
+            values.push_back(v);
+    }
+    return !values.empty();
+}
+
+
+
+//******************************************************************************************/
+//
+// Write through a temporary file, so that path either does not exist or is complete
+//
+//******************************************************************************************/
+static bool writeFile(const string &path, const string &content)
+{
+    string temporaryPath = path + ".tmp";
+
+    FILE *file = fopen(temporaryPath.c_str(), "wb");
+    if (file == NULL)
+        return false;
+
+    bool ok = fwrite(content.data(), 1, content.size(), file) == content.size();
+    ok = (fclose(file) == 0) && ok;
+
+    remove(path.c_str());
+    return ok && rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+static bool fileExists(const string &path)
+{
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == NULL)
+        return false;
+    fclose(file);
+    return true;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+ExperimentGrid::ExperimentGrid()
+{
+    fevals = 10 * 1000;
+    iterations = 5;
+    cpus = 0;
+    threadsPerJob = 1;
+    checkpointInterval = 0;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void ExperimentGrid::load(const string &specFile)
+{
+    ifstream is(specFile.c_str());
+    if (!is)
+    {
+        cerr << "unable to read the experiment grid " << specFile << endl;
+        exit(1);
+    }
+
+    string line;
+    unsigned lineNumber = 0;
+    while (getline(is, line))
+    {
+        ++lineNumber;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty())
+            continue;
+
+        size_t equal = line.find('=');
+        if (equal == string::npos)
+        {
+            cerr << specFile << ":" << lineNumber << ": expected 'key = values'" << endl;
+            exit(1);
+        }
+        string key = trim(line.substr(0, equal));
+        string value = trim(line.substr(equal + 1));
+
+        if (key == "prefix")
+        {
+            prefix = value;
+            continue;
+        }
+
+        vector<unsigned> values;
+        if (!parseValues(value, values))
+        {
+            cerr << specFile << ":" << lineNumber << ": invalid list of values '" << value << "'" << endl;
+            exit(1);
+        }
+
+        if (key == "functions")
+            functions = values;
+        else if (key == "metamodels")
+            metamodels = values;
+        else if (key == "subdims")
+            subdims = values;
+        else if (key == "popsizes")
+            popsizes = values;
+        else if (key == "seeds")
+            seeds = values;
+        else if (key == "fevals" || key == "iterations" || key == "cpus" || key == "threads" || key == "checkpoint")
+        {
+            if (values.size() != 1)
+            {
+                cerr << specFile << ":" << lineNumber << ": " << key << " takes a single value" << endl;
+                exit(1);
+            }
+            if (key == "fevals")
+                fevals = values[0];
+            else if (key == "iterations")
+                iterations = values[0];
+            else if (key == "cpus")
+                cpus = values[0];
+            else if (key == "threads")
+                threadsPerJob = values[0];
+            else
+                checkpointInterval = values[0];
+        }
+        else
+        {
+            cerr << specFile << ":" << lineNumber << ": unknown key '" << key << "'" << endl;
+            exit(1);
+        }
+    }
+
+    if (functions.empty() || metamodels.empty() || subdims.empty() || popsizes.empty() || seeds.empty())
+    {
+        cerr << "the experiment grid requires functions, metamodels, subdims, popsizes and seeds" << endl;
+        exit(1);
+    }
+
+    for (unsigned i = 0; i < functions.size(); ++i)
+        if (functions[i] < 1 || functions[i] > 15)
+        {
+            cerr << "function index out of allowed bounds [1..15]" << endl;
+            exit(1);
+        }
+
+    for (unsigned i = 0; i < metamodels.size(); ++i)
+        if (metamodels[i] > sSVR)
+        {
+            cerr << "unknown surrogate " << metamodels[i] << endl;
+            exit(1);
+        }
+
+    for (unsigned i = 0; i < subdims.size(); ++i)
+        if (subdims[i] < 1 || subdims[i] > 1000)
+        {
+            cerr << "size of subcomponents out of allowed bounds [1..1000]" << endl;
+            exit(1);
+        }
+
+    if (fevals < 1 || iterations < 1 || threadsPerJob < 1)
+    {
+        cerr << "fevals, iterations and threads must be at least 1" << endl;
+        exit(1);
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+// Jobs are ordered by function, so that a worker often reuses the function it already loaded
+//
+//******************************************************************************************/
+vector<ExperimentGrid::Job> ExperimentGrid::jobs()
+{
+    vector<Job> allJobs;
+    for (unsigned f = 0; f < functions.size(); ++f)
+        for (unsigned m = 0; m < metamodels.size(); ++m)
+            for (unsigned s = 0; s < subdims.size(); ++s)
+                for (unsigned p = 0; p < popsizes.size(); ++p)
+                    for (unsigned k = 0; k < seeds.size(); ++k)
+                    {
+                        Job job = { functions[f], metamodels[m], subdims[s], popsizes[p], seeds[k] };
+                        allJobs.push_back(job);
+                    }
+    return allJobs;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+string ExperimentGrid::resultFile(const Job &job)
+{
+    ostringstream os;
+    os << prefix << "f" << job.function << "_m" << job.metamodel << "_s" << job.subdim << "_p" << job.popsize << "_seed" << job.seed << ".csv";
+    return os.str();
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void ExperimentGrid::run(function<Fitness*(unsigned)> fitnessGenerator)
+{
+    vector<Job> allJobs = jobs();
+
+    vector<Job> pending;
+    for (unsigned i = 0; i < allJobs.size(); ++i)
+        if (!fileExists(resultFile(allJobs[i])))
+            pending.push_back(allJobs[i]);
+
+    unsigned numCpus = cpus == 0 ? max(1u, thread::hardware_concurrency()) : cpus;
+    unsigned numWorkers = max(1u, numCpus / threadsPerJob);
+    if (numWorkers > pending.size())
+        numWorkers = max(1u, (unsigned)pending.size());
+
+    cout << allJobs.size() << " jobs, " << allJobs.size() - pending.size() << " already completed, "
+         << pending.size() << " to run on " << numWorkers << " workers with " << threadsPerJob << " threads each" << endl;
+
+    atomic<unsigned> nextJob(0);
+    unsigned completed = 0;
+    double totalEvaluations = 0;
+    mutex outputMutex;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    auto worker = [&]()
+    {
+        //one instance of each function, loaded on first use and reused by the jobs of this worker;
+        //like the objective function of the main driver, they live until the end of the program
+        map<unsigned, Fitness*> instances;
+
+        //optimizers released by a job, reused by the next jobs of this worker with the same sizes
+        JADEPool optimizerPool;
+
+        for (unsigned i = nextJob++; i < pending.size(); i = nextJob++)
+        {
+            const Job &job = pending[i];
+            unsigned functionIndex = job.function;
+
+            Fitness *&f = instances[functionIndex];
+            if (f == NULL)
+                f = fitnessGenerator(functionIndex);
+
+            string file = resultFile(job);
+            string checkpointFile = file + ".checkpoint";
+
+            ostringstream report;
+            vector<ConvPlotPoint> convergence;
+            CCDE ccde;
+            ccde.setOptimizerPool(optimizerPool);
+            ccde.setLog(report);
+            ccde.setCycleMode(threadsPerJob > 1 ? cParallel : cSequential, threadsPerJob,
+                              [fitnessGenerator, functionIndex]() { return fitnessGenerator(functionIndex); });
+            if (checkpointInterval > 0)
+                ccde.setCheckpoint(checkpointFile, checkpointInterval, true);
+            ccde.optimize(f, fevals, job.subdim, job.popsize, convergence, job.seed, (typeOfSurrogate)job.metamodel, iterations);
+
+            ostringstream result;
+            result << "function; metamodel; subdim; popsize; seed; NOE; error; wall time; evaluations/s" << endl;
+            result << job.function << "; " << job.metamodel << "; " << job.subdim << "; " << job.popsize << "; " << job.seed << "; "
+                   << convergence.back().nfe << "; " << std::scientific << setprecision(8) << convergence.back().f << "; "
+                   << ccde.wallTime << "; " << ccde.throughput << endl;
+            result << endl << "NOE; error" << endl;
+            for (unsigned q = 0; q < convergence.size(); ++q)
+                result << convergence[q].nfe << "; " << convergence[q].f << endl;
+
+            bool written = writeFile(file, result.str());
+            if (written && checkpointInterval > 0)
+                remove(checkpointFile.c_str());
+
+            lock_guard<mutex> lock(outputMutex);
+            ++completed;
+            totalEvaluations += convergence.back().nfe;
+            if (!written)
+                cerr << "unable to write " << file << endl;
+            cout << "[" << completed << "/" << pending.size() << "] f" << job.function << " m" << job.metamodel << " s" << job.subdim
+                 << " p" << job.popsize << " seed " << job.seed << ": NOE=" << convergence.back().nfe
+                 << "  err=" << std::scientific << convergence.back().f << "  wall time=" << ccde.wallTime
+                 << " s  " << ccde.throughput << " evaluations/s" << endl;
+        }
+    };
+
+    vector<thread> workers;
+    for (unsigned w = 1; w < numWorkers; ++w)
+        workers.push_back(thread(worker));
+    worker();
+    for (unsigned w = 0; w < workers.size(); ++w)
+        workers[w].join();
+
+    double wallTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Experiment wall time = " << wallTime << " s  throughput = " << (wallTime > 0 ? totalEvaluations / wallTime : 0) << " evaluations/s" << endl;
+
+    writeSummary(allJobs);
+}
+
+
+
+//******************************************************************************************/
+//
+// Collect the summary line of every completed job, including those of previous runs
+//
+//******************************************************************************************/
+void ExperimentGrid::writeSummary(vector<Job> &allJobs)
+{
+    ostringstream summary;
+    summary << "function; metamodel; subdim; popsize; seed; NOE; error; wall time; evaluations/s" << endl;
+
+    unsigned numCompleted = 0;
+    for (unsigned i = 0; i < allJobs.size(); ++i)
+    {
+        ifstream is(resultFile(allJobs[i]).c_str());
+        string header, line;
+        if (is && getline(is, header) && getline(is, line))
+        {
+            summary << line << endl;
+            ++numCompleted;
+        }
+    }
+
+    string file = prefix + "summary.csv";
+    if (!writeFile(file, summary.str()))
+        cerr << "unable to write " << file << endl;
+    else
+        cout << "Summary of " << numCompleted << "/" << allJobs.size() << " completed jobs written to " << file << endl;
+}
@@ -0,0 +1,86 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : ExperimentGrid.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <functional>
+#include "Fitness.h"
+
+using namespace std;
+
+
+/**
+	@brief Full-factorial experiment: every combination of function, metamodel, size of the subcomponents,
+	population size and seed is a job, run on a local pool of worker threads.
+
+	The grid is read from a text file of 'key = values' lines, where values are comma-separated numbers
+	or ranges such as 1-15; '#' starts a comment:
+
+	    functions   = 1-15
+	    metamodels  = 0,2
+	    subdims     = 5,10
+	    popsizes    = 10
+	    seeds       = 0-24
+	    fevals      = 3000000       (exact evaluations per job)
+	    iterations  = 5             (JADE iterations per cycle)
+	    cpus        = 0             (hardware threads to use, 0 -> all)
+	    threads     = 1             (threads of each job; more than one -> parallel cycle)
+	    checkpoint  = 10            (cycles between checkpoints of a running job, 0 -> none)
+	    prefix      = results/      (prepended to every output file; directories must exist)
+
+	Each job writes its own result file only when it completes, through a temporary file and a rename,
+	so a result file on disk is always complete; jobs whose result file exists are skipped, which makes
+	an interrupted experiment resumable by running it again. With checkpoints, an interrupted job
+	continues from its last checkpoint instead of restarting.
+*/
+class ExperimentGrid
+{
+public:
+    vector<unsigned> functions;
+    vector<unsigned> metamodels;
+    vector<unsigned> subdims;
+    vector<unsigned> popsizes;
+    vector<unsigned> seeds;
+    unsigned fevals;
+    unsigned iterations;
+    unsigned cpus;
+    unsigned threadsPerJob;
+    unsigned checkpointInterval;
+    string prefix;
+
+    ExperimentGrid();
+
+    ///Read the grid from file; syntax errors terminate the program
+    void load(const string &specFile);
+
+    ///Run all the jobs without a result file; fitnessGenerator(i) returns a new instance of function i.
+    ///At the end, the summary of all the completed jobs is written to <prefix>summary.csv
+    void run(function<Fitness*(unsigned)> fitnessGenerator);
+
+private:
+    struct Job
+    {
+        unsigned function;
+        unsigned metamodel;
+        unsigned subdim;
+        unsigned popsize;
+        unsigned seed;
+    };
+
+    vector<Job> jobs();
+    string resultFile(const Job &job);
+    void writeSummary(vector<Job> &allJobs);
+};
@@ -21,27 +21,39 @@
 
 using namespace std;
 
+
+///Full-dimensional candidates are built in buffers shared by all the optimizers running on the same
+///thread: one candidate, and the candidates in flight of the steady-state mode
+static thread_local vector<double> candidate;
+static thread_local vector<double> candidatesInFlight;
+
+
 //******************************************************************************************/
 //
 //
 //
 //******************************************************************************************/
 JADE::JADE(unsigned _dimension, unsigned _numberOfIndividuals, Decomposer &_group, typeOfSurrogate _sType) :
-    decomposer(_group), dimension(_dimension), numberOfIndividuals(_numberOfIndividuals), sType(_sType)
+    decomposer(&_group), dimension(_dimension), numberOfIndividuals(_numberOfIndividuals), sType(_sType)
 {
-    JADE_mu_cr = 0.5;
-    JADE_mu_ff = 0.5;
-    nfe = 0;
-    parentsFitness.resize(numberOfIndividuals, 0);
-    parentHasTrueFitness.resize(numberOfIndividuals, false);
-    offspringsFitness.resize(numberOfIndividuals, 0);
-    FF.resize(numberOfIndividuals, 0);
-    CR.resize(numberOfIndividuals, 0);
-    SSFF.resize(numberOfIndividuals, 0);
-    SSCR.resize(numberOfIndividuals, 0);
-    indexOfBest = (unsigned)(numberOfIndividuals * unifRandom(decomposer.eng));
-    binaryVector.resize(dimension, 0);
-    xp.resize(decomposer.CCOptimizer.problemDimension);
+    rowStride = (dimension + 3) & ~3u;
+    parentsBuffer.assign((size_t)numberOfIndividuals * rowStride, 0);
+    offspringsBuffer.assign((size_t)numberOfIndividuals * rowStride, 0);
+    offspringsVariance.resize(numberOfIndividuals, 0);
+    toEvaluate.resize(numberOfIndividuals, 0);
+    offspringHasTrueFitness.resize(numberOfIndividuals, 0);
+    alreadyEvaluated.resize(numberOfIndividuals, 0);
+    offspringOrder.resize(numberOfIndividuals, 0);
+    sortIndex.reserve(numberOfIndividuals);
+    targetInFlight.resize(numberOfIndividuals, 0);
+    freeSlots.reserve(numberOfIndividuals);
+    batchFitness.reserve(numberOfIndividuals);
+    batchIndexes.reserve(numberOfIndividuals);
+    crossoverStream.resize(dimension);
+    surrogateInput.resize(dimension);
+    kernels = SubcomponentKernels::forSize(dimension);
+    lowerBlock.resize(dimension);
+    upperBlock.resize(dimension);
 
     minCoordInArchive.resize(dimension, 0);
     maxCoordInArchive.resize(dimension, 0);
@@ -63,13 +75,9 @@ JADE::JADE(unsigned _dimension, unsigned _numberOfIndividuals, Decomposer &_grou
     gpPars_l.push_back(log(1.0E-9));
     gpPars_u.push_back(log(1.0E-2));
 
-    for (int i = 0; i < numGPPars; ++i)
-        gpPars[i] = (gpPars_l[i] + gpPars_u[i]) / 2.0;
-
     gp = NULL;
     rbfn = NULL;
     qr = NULL;
-    surrogateIsValid = false;
 
     if (sType == sQPA || sType==sNone )
     {
@@ -93,6 +101,44 @@ JADE::JADE(unsigned _dimension, unsigned _numberOfIndividuals, Decomposer &_grou
     else if (sType == sRBFN) rbfn = new RBFNetwork();
     archive = new vector< Pattern >;
 
+    reset(_group);
+}
+
+
+
+//******************************************************************************************/
+//
+// Bring the optimizer back to the state of a newly constructed one, working for the given
+// decomposer. The buffers and the surrogate objects are kept: the surrogates are rebuilt from
+// the archive, which is emptied (see JADEPool)
+//
+//******************************************************************************************/
+void JADE::reset(Decomposer &_group)
+{
+    decomposer = &_group;
+    JADE_mu_cr = 0.5;
+    JADE_mu_ff = 0.5;
+    nfe = 0;
+    subcomponent = 0;
+    blockStart = 0;
+    numberOfParents = 0;
+    coordinates.clear();
+    engine.seed(RandomEngine::default_seed);
+    parentsFitness.assign(numberOfIndividuals, 0);
+    parentHasTrueFitness.assign(numberOfIndividuals, false);
+    parentIsStale.assign(numberOfIndividuals, false);
+    offspringsFitness.assign(numberOfIndividuals, 0);
+    FF.assign(numberOfIndividuals, 0);
+    CR.assign(numberOfIndividuals, 0);
+    SSFF.assign(numberOfIndividuals, 0);
+    SSCR.assign(numberOfIndividuals, 0);
+    indexOfBest = (unsigned)(numberOfIndividuals * unifRandom(decomposer->eng));
+
+    for (int i = 0; i < numGPPars; ++i)
+        gpPars[i] = (gpPars_l[i] + gpPars_u[i]) / 2.0;
+
+    archive->clear();
+    surrogateIsValid = false;
 }
 
 
@@ -117,9 +163,103 @@ JADE::~JADE()
 //
 //
 //******************************************************************************************/
-vector<double> &JADE::getCollaborator()
+double *JADE::getCollaborator()
+{
+    return parent(indexOfBest);
+}
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void JADE::setStream(uint64_t seed, uint64_t stream)
 {
-    return parents[indexOfBest];
+    engine.seed(seed, stream);
+}
+
+
+//******************************************************************************************/
+//
+// State needed to continue the search at the beginning of a cycle: the surrogates are rebuilt
+// from the archive, and the offspring and the CR/F values of each generation are regenerated
+//
+//******************************************************************************************/
+void JADE::saveState(CheckpointWriter &w)
+{
+    w.putVector(coordinates);
+    w.put(JADE_mu_cr);
+    w.put(JADE_mu_ff);
+    w.put(nfe);
+    w.put(indexOfBest);
+    w.put(besdouble);
+
+    w.put((uint64_t)numberOfParents);
+    for (unsigned i = 0; i < numberOfParents; ++i)
+        w.putVector(vector<double>(parent(i), parent(i) + dimension));
+    w.putVector(parentsFitness);
+    w.putVector(parentHasTrueFitness);
+    w.putVector(parentIsStale);
+
+    w.put((uint64_t)archive->size());
+    for (unsigned i = 0; i < archive->size(); ++i)
+    {
+        w.putVector((*archive)[i].point);
+        w.put((*archive)[i].fitness);
+    }
+
+    w.putEngine(engine);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void JADE::loadState(CheckpointReader &r)
+{
+    uint64_t n;
+
+    r.getVector(coordinates);
+    r.get(JADE_mu_cr);
+    r.get(JADE_mu_ff);
+    r.get(nfe);
+    r.get(indexOfBest);
+    r.get(besdouble);
+
+    r.get(n);
+    if (n > numberOfIndividuals)
+    {
+        cerr << "the checkpoint was saved with a different number of individuals" << endl;
+        exit(1);
+    }
+    numberOfParents = (unsigned)n;
+    vector<double> row;
+    for (unsigned i = 0; i < numberOfParents; ++i)
+    {
+        r.getVector(row);
+        copy(row.begin(), row.end(), parent(i));
+    }
+    r.getVector(parentsFitness);
+    r.getVector(parentHasTrueFitness);
+    r.getVector(parentIsStale);
+
+    r.get(n);
+    archive->clear();
+    for (uint64_t i = 0; i < n; ++i)
+    {
+        vector<double> point;
+        double fitness;
+        r.getVector(point);
+        r.get(fitness);
+        archive->push_back(Pattern(point, fitness));
+    }
+    surrogateIsValid = false;
+
+    r.getEngine(engine);
 }
 
 
@@ -173,7 +313,7 @@ void JADE::setArchive(vector<Pattern> *a)
 void JADE::updateContextVector()
 {
     for (unsigned ld = 0; ld < coordinates.size(); ld++)
-        decomposer.contextVector[coordinates[ld]] = parents[indexOfBest][ld];
+        decomposer->contextVector[coordinates[ld]] = parent(indexOfBest)[ld];
 }
 
 
@@ -186,7 +326,7 @@ void JADE::updateContextVector(vector<double> &cv, vector<unsigned> &coords, uns
 {
     for (unsigned ld = 0; ld < coordinates.size(); ld++)
     {
-        cv[vi + ld] = parents[indexOfBest][ld];
+        cv[vi + ld] = parent(indexOfBest)[ld];
         coords[vi + ld] = coordinates[ld];
     }
     vi += coordinates.size();
@@ -215,52 +355,58 @@ void JADE::createGP()
 
 //******************************************************************************************/
 //
-//
-//
-//******************************************************************************************/
-void JADE::setCoordinates(vector<unsigned> &_coordinates)
-{
-    coordinates = _coordinates;
-};
-
-
-//******************************************************************************************/
-//
-//
+// The coordinates are a block of those of the decomposer, whose position is kept in blockStart
 //
 //******************************************************************************************/
 void JADE::setCoordinates(unsigned *_coordinates, unsigned numOfCoordinates)
 {
+    blockStart = _coordinates - &decomposer->coordinates[0];
+
     if (coordinates.size() == numOfCoordinates)
     {
         for (unsigned i = 0; i < numOfCoordinates; ++i)
             coordinates[i] = _coordinates[i];
+        gatherBounds();
         return;
     }
 
     coordinates.clear();
     for (unsigned i = 0; i < numOfCoordinates; ++i)
         coordinates.push_back(_coordinates[i]);
+    gatherBounds();
 }
 
 
 //******************************************************************************************/
 //
+// Bounds of the coordinates of the subcomponent, contiguous for trialKernel
+//
+//******************************************************************************************/
+void JADE::gatherBounds()
+{
+    for (unsigned j = 0; j < coordinates.size() && j < dimension; ++j)
+    {
+        lowerBlock[j] = decomposer->CCOptimizer.lowerBound[coordinates[j]];
+        upperBlock[j] = decomposer->CCOptimizer.upperBound[coordinates[j]];
+    }
+}
+
+
+//******************************************************************************************/
 //
+// The population of the decomposer is laid out in the order of its coordinates, so the
+// variables of this subcomponent are a contiguous block of each row, copied in the rows of the
+// parents
 //
 //******************************************************************************************/
 void JADE::loadIndividuals(vector< vector<double> > &population)
 {
-    parents.clear();
+    numberOfParents = (unsigned)min((size_t)numberOfIndividuals, population.size());
 
-    for (unsigned i = 0; i < numberOfIndividuals && i < population.size(); ++i)
+    for (unsigned i = 0; i < numberOfParents; ++i)
     {
-        vector< double > position;
-
-        for (unsigned ld = 0; ld < coordinates.size(); ld++)
-            position.push_back(population[i][coordinates[ld]]);
-
-        parents.push_back(position);
+        const double *block = &population[i][blockStart];
+        copy(block, block + coordinates.size(), parent(i));
     }
 }
 
@@ -273,8 +419,7 @@ void JADE::loadIndividuals(vector< vector<double> > &population)
 void JADE::updateIndividuals(vector< vector<double> > &population)
 {
     for (unsigned i = 0; i < numberOfIndividuals && i < population.size(); ++i)
-        for (unsigned ld = 0; ld < coordinates.size(); ld++)
-            parents[i][ld] = population[i][coordinates[ld]];
+        copy(population[i].begin() + blockStart, population[i].begin() + blockStart + coordinates.size(), parent(i));
 }
 
 
@@ -286,8 +431,7 @@ void JADE::updateIndividuals(vector< vector<double> > &population)
 void JADE::storeIndividuals(vector< vector<double> > &population)
 {
     for (unsigned i = 0; i < numberOfIndividuals && i < population.size(); ++i)
-        for (unsigned ld = 0; ld < coordinates.size(); ld++)
-            population[i][coordinates[ld]] = parents[i][ld];
+        copy(parent(i), parent(i) + coordinates.size(), population[i].begin() + blockStart);
 }
 
 
@@ -310,11 +454,21 @@ void JADE::sortPopulation(vector<double> &fitness, vector<int> &sortIndex)
 
 //******************************************************************************************/
 //
-//
+// One generation of JADE, with or without surrogate: the policies are template parameters, so
+// every combination is compiled separately and the loops of the generation test no type of
+// surrogate nor mutation strategy. N is the size of the subcomponent when it is a usual one
+// (0 otherwise), for which the trial kernel is inlined with a constant trip count. Only an
+// assisted generation with enough patterns in the archive uses the surrogate; the others
+// evaluate all the offspring exactly.
 //
 //******************************************************************************************/
-void JADE::SAUpdate(typeOfSurrogate sType)
+template<class Surrogate, class Mutation, unsigned N>
+void JADE::generation()
 {
+    scratch.reset();
+
+    evaluateStaleBest();
+
     //Sort the population from best to worst
     sortPopulation(parentsFitness, sortIndex);
     //Generate the CR and F values based on Gaussian and Cauchy distribution, respectively
@@ -322,145 +476,79 @@ void JADE::SAUpdate(typeOfSurrogate sType)
 
     normal_distribution<double> gaussian(JADE_mu_cr, 0.1);
 
-    for (unsigned int i = 0; i < parents.size(); i++)
+    for (unsigned int i = 0; i < numberOfParents; i++)
     {
         do
         {
-            FF[i] = cauchy(decomposer.eng);
+            FF[i] = cauchy(engine);
         } while (FF[i] <= 0.0);
 
         if (FF[i] > 1.0) FF[i] = 1.0;
 
-        CR[i] = gaussian(decomposer.eng);
+        CR[i] = gaussian(engine);
 
         if (CR[i] < 0.0) CR[i] = 0.0;
 
         if (CR[i] > 1.0) CR[i] = 1.0;
     }
 
-    offsprings.clear();
-    vector<bool> toEvaluate;
-    for (unsigned int i = 0; i < parents.size(); i++)
+    for (unsigned int i = 0; i < numberOfParents; i++)
     {
-        unsigned r1, r2, r3;
-        //Generate the mutant vector
-        //Randomly choose the p_best individual
-        unsigned p_index = unifRandom(decomposer.eng) * parents.size() * decomposer.CCOptimizer.JADE_p;
-        p_index = sortIndex[p_index];
-
-        //Select three parents randomly
-        do
-        {
-            r1 = unifRandom(decomposer.eng) * parents.size();
-        } while (r1 == i);
-
-        do
-        {
-            r2 = unifRandom(decomposer.eng) * parents.size();
-        } while (r2 == i || r2 == r1);
-
-        do
-        {
-            r3 = unifRandom(decomposer.eng) * parents.size();
-        } while (r3 == i || r3 == r2 || r3 == r1);
-
-        vector<double> child(dimension, 0);
-
-        for (unsigned int j = 0; j < dimension; j++)
-        {
-            if (decomposer.CCOptimizer.JADE_mutationStrategy == 1)
-            {
-                child[j] = parents[i][j] +
-                           FF[i] * (parents[p_index][j] - parents[i][j]) +
-                           FF[i] * (parents[r1][j] - parents[r2][j]);
-            }
-            else if (decomposer.CCOptimizer.JADE_mutationStrategy == 2)
-            {
-                child[j] = parents[r1][j] +
-                           FF[i] * (parents[p_index][j] - parents[r1][j]) +
-                           FF[i] * (parents[r2][j] - parents[r3][j]);
-            }
-
-            if (child[j] < decomposer.CCOptimizer.lowerLimit || child[j] > decomposer.CCOptimizer.upperLimit)
-                child[j] = decomposer.CCOptimizer.lowerLimit + unifRandom(decomposer.eng) * (decomposer.CCOptimizer.upperLimit - decomposer.CCOptimizer.lowerLimit);
-        }
-
-        offsprings.push_back(child);
-        toEvaluate.push_back(false);
-
-        //Generate the binary vector based on the binomial crossover
-        unsigned j_rnd = dimension * unifRandom(decomposer.eng);
-
-        for (unsigned j = 0; j < dimension; j++)
-        {
-            if (unifRandom(decomposer.eng) < CR[i] || j == j_rnd)
-                binaryVector[j] = 1;
-            else
-                binaryVector[j] = 0;
-        }
-
-        //Repair the crossover rate with its binary vector generated above
-        unsigned int tt = 0;
-
-        for (unsigned int j = 0; j < dimension; j++)
-            tt += binaryVector[j];
-
-        CR[i] = (double)tt / ((double)dimension);
-
-        //Generate the trial vector based on the binary vector and the mutant vector
-        for (unsigned int j = 0; j < dimension; j++)
-            if (binaryVector[j] == 0)
-                offsprings[i][j] = parents[i][j];
-            else
-                toEvaluate[i] = true;
+        toEvaluate[i] = createTrial<Mutation, N>(i, FF[i], CR[i], offspring(i));
+        offspringHasTrueFitness[i] = true;
+        alreadyEvaluated[i] = false;
+        offspringsVariance[i] = 0.0;
     }
 
     //Evaluate the offspring population
-    vector<bool> offspringHasTrueFitness(offsprings.size(), true);
-    vector<bool> alreadyEvaluated(offsprings.size(), false);
-    bool failureInSurrogate = false;
-
-    offspringsVariance.resize(offsprings.size());
-
-    if (archive->size() <  minNumberOfPatterns)
+    if (!Surrogate::assisted || archive->size() < minNumberOfPatterns)
     {
-        evaluateOffsprings(toEvaluate, offspringHasTrueFitness);
+        evaluateOffsprings();
 
-        for (int j = 0; j < offsprings.size(); ++j)
+        for (int j = 0; j < numberOfParents; ++j)
             alreadyEvaluated[j] = true;
     }
     else
     {
-        if (sType == sGP || sType == sRBFN || sType == sSVR )
+        if (Surrogate::global)
             trainGlobalSurrogate();
 
-        unsigned nSurrogateEvals = 0;
-        for (unsigned id = 0; id < offsprings.size(); ++id)
+        //the surrogate replaces the fitness carried over by the stale parents
+        for (unsigned i = 0; i < numberOfParents; ++i)
+            if (parentIsStale[i])
+            {
+                bool isTrueFitness = false;
+                double f = calculateSurrogateFitnessValue(parent(i), Surrogate::type, isTrueFitness);
+                if (isinf(f) || isnan(f))
+                    continue;
+                parentsFitness[i] = f;
+                parentHasTrueFitness[i] = isTrueFitness;
+                parentIsStale[i] = false;
+            }
+
+        for (unsigned id = 0; id < numberOfParents; ++id)
         {
             if (toEvaluate[id])
             {
                 if (!alreadyEvaluated[id])
                 {
                     bool isTrueFitness = false;
-                    offspringsFitness[id] = calculateSurrogateFitnessValue(offsprings[id], sType, isTrueFitness);
-					//double tf = calculateFitnessValue(offsprings[id], true);
-					//cout << tf << " " << fabs(tf - offspringsFitness[id]) << endl;
+                    offspringsFitness[id] = calculateSurrogateFitnessValue(offspring(id), Surrogate::type, isTrueFitness);
                     offspringHasTrueFitness[id] = isTrueFitness;
                     alreadyEvaluated[id] = true;
 
                     if (isinf(offspringsFitness[id]) || isnan(offspringsFitness[id]))
                     {
-                        failureInSurrogate = true;
-						cout << "failure in surrogate" << endl;
-                        offspringsFitness[id] = calculateFitnessValue(offsprings[id], true);
+						*decomposer->CCOptimizer.log << "failure in surrogate" << endl;
+                        offspringsFitness[id] = calculateFitnessValue(offspring(id), true, eSurrogate);
                         offspringHasTrueFitness[id] = true;
                         offspringsVariance[id] = 0.0;
                     }
                     else
                     {
                         double var = 0.0;
-                        if ( sType==sGP )
-                            var = calculateGPSurrogatePredictionVariance(offsprings[id]);
+                        if (Surrogate::variance)
+                            var = calculateGPSurrogatePredictionVariance(offspring(id));
                         offspringsVariance[id] = var;
                     }
                 }
@@ -476,54 +564,54 @@ void JADE::SAUpdate(typeOfSurrogate sType)
 
     }
 
-    vector<int> sortIndex;
-    sortIndex.resize(offspringsVariance.size());
-    for (unsigned int j = 0; j < offspringsVariance.size(); j++)
-        sortIndex[j] = j;
-
-
-    //Evaluate with the true fitness the offspring individual with the highest variance
-    if ( sType == sGP )
+    if (Surrogate::assisted)
     {
-        int imv = 0;
-        double maxV = offspringsVariance[0];
-        for (int q=1; q<sortIndex.size(); ++q)
-            if (offspringsVariance[q]>maxV)
+        //Evaluate with the true fitness the offspring individual with the highest variance
+        if (Surrogate::variance)
+        {
+            int imv = 0;
+            double maxV = offspringsVariance[0];
+            for (int q=1; q<numberOfParents; ++q)
+                if (offspringsVariance[q]>maxV)
+                {
+                    maxV = offspringsVariance[q];
+                    imv = q;
+                }
+
+            if (!offspringHasTrueFitness[imv])
             {
-                maxV = offspringsVariance[q];
-                imv = q;
+                offspringsFitness[imv] = calculateFitnessValue(offspring(imv), true, eSurrogate);
+                offspringHasTrueFitness[imv] = true;
             }
+        }
+
+        //Evaluate with the exact fitness the best individual
+        int *order = &offspringOrder[0];
+        for (unsigned int j = 0; j < numberOfParents; j++)
+            order[j] = j;
 
-        if (!offspringHasTrueFitness[imv])
+        sort(order, order + numberOfParents, doCompareIndividuals(&offspringsFitness[0]));
+        while (!offspringHasTrueFitness[order[0]] )
         {
-            offspringsFitness[imv] = calculateFitnessValue(offsprings[imv]);
-            offspringHasTrueFitness[imv] = true;
+            offspringsFitness[order[0]] = calculateFitnessValue(offspring(order[0]), true, eSurrogate);
+            offspringHasTrueFitness[order[0]] = true;
+            sort(order, order + numberOfParents, doCompareIndividuals(&offspringsFitness[0]));
         }
     }
 
-
-    //Evaluate with the exact fitness the best individual
-	sort(&sortIndex[0], &sortIndex[0] + sortIndex.size(), doCompareIndividuals(&offspringsFitness[0]));
-	while (!offspringHasTrueFitness[sortIndex[0]] )
-    {
-        offspringsFitness[sortIndex[0]] = calculateFitnessValue(offsprings[sortIndex[0]]);
-        offspringHasTrueFitness[sortIndex[0]] = true;
-        sort(&sortIndex[0], &sortIndex[0] + sortIndex.size(), doCompareIndividuals(&offspringsFitness[0]));
-    }
     //Selection and save the successful parameters
     SSFF.clear();
     SSCR.clear();
 
-    for (unsigned int i = 0; i < parents.size(); i++)
+    for (unsigned int i = 0; i < numberOfParents; i++)
     {
         if (offspringsFitness[i] <= parentsFitness[i])
         {
-
-            for (unsigned int j = 0; j < dimension; j++)
-                parents[i][j] = offsprings[i][j];
+            copy(offspring(i), offspring(i) + dimension, parent(i));
 
             parentsFitness[i] = offspringsFitness[i];
             parentHasTrueFitness[i] = offspringHasTrueFitness[i];
+            parentIsStale[i] = parentIsStale[i] && !toEvaluate[i];
 
             //Save the successful CR and F values
             SSFF.push_back(FF[i]);
@@ -540,7 +628,7 @@ void JADE::SAUpdate(typeOfSurrogate sType)
             mean_cr += SSCR[i];
         mean_cr = mean_cr / ((double)SSCR.size());
 
-        JADE_mu_cr = (1 - decomposer.CCOptimizer.JADE_c) * JADE_mu_cr + decomposer.CCOptimizer.JADE_c * mean_cr;
+        JADE_mu_cr = (1 - decomposer->CCOptimizer.JADE_c) * JADE_mu_cr + decomposer->CCOptimizer.JADE_c * mean_cr;
 
         //Update the mu_F value
         double mean_ff = 0.0;
@@ -556,7 +644,7 @@ void JADE::SAUpdate(typeOfSurrogate sType)
         mean_ff = t1 / t2;
 
         //Lehmer mean
-        JADE_mu_ff = (1 - decomposer.CCOptimizer.JADE_c) * JADE_mu_ff + decomposer.CCOptimizer.JADE_c * mean_ff;
+        JADE_mu_ff = (1 - decomposer->CCOptimizer.JADE_c) * JADE_mu_ff + decomposer->CCOptimizer.JADE_c * mean_ff;
     }
 }
 
@@ -564,167 +652,201 @@ void JADE::SAUpdate(typeOfSurrogate sType)
 
 //******************************************************************************************/
 //
-//
+// Mutation (current-to-pbest/1 or rand-to-pbest/1) and binomial crossover for the target i.
+// Cr is repaired with the actual fraction of mutated coordinates. Returns false if the trial
+// coincides with its target, which therefore does not need to be evaluated. With N = 0 the
+// kernel is called through SubcomponentKernels, otherwise its instance for N is inlined.
 //
 //******************************************************************************************/
-void JADE::update()
+template<class Mutation, unsigned N>
+bool JADE::createTrial(unsigned i, double F, double &Cr, double *child)
 {
-    //Sort the population from best to worst
-    sortPopulation(parentsFitness, sortIndex);
-
-    //Generate the CR and F values based on Gaussian and Cauchy distribution, respectively
-    cauchy_distribution<double> cauchy(JADE_mu_ff, 0.1);
-
-    normal_distribution<double> gaussian(JADE_mu_cr, 0.1);
-
-    for (unsigned int i = 0; i < parents.size(); i++)
+    unsigned r1, r2, r3;
+    //Generate the mutant vector
+    //Randomly choose the p_best individual
+    unsigned p_index = unifRandom(engine) * numberOfParents * decomposer->CCOptimizer.JADE_p;
+    p_index = sortIndex[p_index];
+
+    //Select three parents randomly
+    do
     {
-        do
-        {
-            FF[i] = cauchy(decomposer.eng);
-        } while (FF[i] <= 0.0);
+        r1 = unifRandom(engine) * numberOfParents;
+    } while (r1 == i);
 
-        if (FF[i] > 1.0) FF[i] = 1.0;
+    do
+    {
+        r2 = unifRandom(engine) * numberOfParents;
+    } while (r2 == i || r2 == r1);
 
-        CR[i] = gaussian(decomposer.eng);
+    do
+    {
+        r3 = unifRandom(engine) * numberOfParents;
+    } while (r3 == i || r3 == r2 || r3 == r1);
 
-        if (CR[i] < 0.0) CR[i] = 0.0;
+    const double *xi = parent(i), *xp = parent(p_index), *x1 = parent(r1), *x2 = parent(r2), *x3 = parent(r3);
 
-        if (CR[i] > 1.0) CR[i] = 1.0;
-    }
+    //The random numbers of the binomial crossover are drawn before the pass over the coordinates
+    unsigned j_rnd = dimension * unifRandom(engine);
 
-    offsprings.clear();
-    vector<bool> toEvaluate;
-    for (unsigned int i = 0; i < parents.size(); i++)
-    {
-        unsigned r1, r2, r3;
-        //Generate the mutant vector
-        //Randomly choose the p_best individual
-        unsigned p_index = unifRandom(decomposer.eng) * parents.size() * decomposer.CCOptimizer.JADE_p;
-        p_index = sortIndex[p_index];
+    double *u = &crossoverStream[0];
+    engine.fill(u, dimension);
+    u[j_rnd] = -1.0;
 
-        //Select three parents randomly
-        do
-        {
-            r1 = unifRandom(decomposer.eng) * parents.size();
-        } while (r1 == i);
+    //the strategy selects the operands, and the kernel does not branch on it
+    const double *base, *d1, *d2;
+    Mutation::operands(xi, x1, x2, x3, base, d1, d2);
 
-        do
-        {
-            r2 = unifRandom(decomposer.eng) * parents.size();
-        } while (r2 == i || r2 == r1);
+    bool outOfBounds;
+    unsigned tt;
+    if (N)
+        tt = trialOfSize<N>(N, F, Cr, xi, base, xp, d1, d2, u, &lowerBlock[0], &upperBlock[0], child, outOfBounds);
+    else
+        tt = kernels.trial(dimension, F, Cr, xi, base, xp, d1, d2, u, &lowerBlock[0], &upperBlock[0], child, outOfBounds);
 
-        do
-        {
-            r3 = unifRandom(decomposer.eng) * parents.size();
-        } while (r3 == i || r3 == r2 || r3 == r1);
+    //Mutated coordinates outside the domain are reinitialized at random
+    if (outOfBounds)
+        for (unsigned j = 0; j < dimension; j++)
+            if (child[j] < lowerBlock[j] || child[j] > upperBlock[j])
+                child[j] = lowerBlock[j] + unifRandom(engine) * (upperBlock[j] - lowerBlock[j]);
 
-        vector<double> child(dimension, 0);
+    //Repair the crossover rate with the actual fraction of mutated coordinates
+    Cr = (double)tt / ((double)dimension);
 
-        for (unsigned int j = 0; j < dimension; j++)
-        {
-            if (decomposer.CCOptimizer.JADE_mutationStrategy == 1)
-            {
-                child[j] = parents[i][j] +
-                           FF[i] * (parents[p_index][j] - parents[i][j]) +
-                           FF[i] * (parents[r1][j] - parents[r2][j]);
-            }
-            else if (decomposer.CCOptimizer.JADE_mutationStrategy == 2)
-            {
-                child[j] = parents[r1][j] +
-                           FF[i] * (parents[p_index][j] - parents[r1][j]) +
-                           FF[i] * (parents[r2][j] - parents[r3][j]);
-            }
+    return tt > 0;
+}
 
-            if (child[j] < decomposer.CCOptimizer.lowerLimit || child[j] > decomposer.CCOptimizer.upperLimit)
-                child[j] = decomposer.CCOptimizer.lowerLimit + unifRandom(decomposer.eng) * (decomposer.CCOptimizer.upperLimit - decomposer.CCOptimizer.lowerLimit);
-        }
 
-        offsprings.push_back(child);
-        toEvaluate.push_back(false);
 
-        //Generate the binary vector based on the binomial crossover
-        unsigned j_rnd = dimension * unifRandom(decomposer.eng);
+//******************************************************************************************/
+//
+// Trial with the mutation strategy chosen at run time (steady-state mode)
+//
+//******************************************************************************************/
+bool JADE::createTrial(unsigned i, double F, double &Cr, double *child)
+{
+    if (decomposer->CCOptimizer.JADE_mutationStrategy == 2)
+        return createTrial<RandToPBest, 0>(i, F, Cr, child);
+    return createTrial<CurrentToPBest, 0>(i, F, Cr, child);
+}
 
-        for (unsigned j = 0; j < dimension; j++)
-        {
-            if (unifRandom(decomposer.eng) < CR[i] || j == j_rnd)
-                binaryVector[j] = 1;
-            else
-                binaryVector[j] = 0;
-        }
 
-        //Repair the crossover rate with its binary vector generated above
-        unsigned int tt = 0;
 
-        for (unsigned int j = 0; j < dimension; j++)
-            tt += binaryVector[j];
 
-        CR[i] = (double)tt / ((double)dimension);
+//******************************************************************************************/
+//
+// Asynchronous steady-state JADE: up to CCDE::numInFlight trials are evaluated concurrently by the
+// workers of CCDE::pool. As soon as an evaluation completes, the trial competes with its target,
+// mu_CR and mu_F are adapted with its parameters if successful, and a new trial is submitted in
+// the freed slot. Targets with a trial in flight are skipped, so each trial replaces its own
+// target. Only the exact fitness is used (no surrogate).
+//
+//******************************************************************************************/
+void JADE::steadyStateOptimize(unsigned numOfTrials)
+{
+    CCDE &CCOptimizer = decomposer->CCOptimizer;
+    EvaluationBudget &budget = CCOptimizer.budget;
+    unsigned D = CCOptimizer.problemDimension;
+    unsigned numSlots = min(CCOptimizer.numInFlight, numberOfIndividuals);
 
-        //Generate the trial vector based on the binary vector and the mutant vector
-        for (unsigned int j = 0; j < dimension; j++)
-            if (binaryVector[j] == 0)
-                offsprings[i][j] = parents[i][j];
-            else
-                toEvaluate[i] = true;
-    }
+    trialTarget.resize(numSlots);
+    candidatesInFlight.resize((size_t)numSlots * D);
+    completions.reset(numSlots);
 
-    //Evaluate the child population
-    vector<bool> offspringHasTrueFitness(offsprings.size(), true);
-    evaluateOffsprings(toEvaluate, offspringHasTrueFitness);
+    targetInFlight.assign(numberOfIndividuals, 0);
+    freeSlots.clear();
+    for (unsigned s = 0; s < numSlots; ++s)
+        freeSlots.push_back(numSlots - 1 - s);
 
+    evaluateStaleBest();
+    sortPopulation(parentsFitness, sortIndex);
 
-    //Selection and save the successful parameters
-    SSFF.clear();
-    SSCR.clear();
+    unsigned launched = 0;
+    unsigned inFlight = 0;
+    unsigned nextTarget = 0;
 
-    for (unsigned int i = 0; i < parents.size(); i++)
+    for (;;)
     {
-        if (offspringsFitness[i] <= parentsFitness[i])
+        //fill the free slots
+        while (!freeSlots.empty() && launched < numOfTrials)
         {
-            for (unsigned int j = 0; j < dimension; j++)
-                parents[i][j] = offsprings[i][j];
+            unsigned s = freeSlots.back();
 
-            parentsFitness[i] = offspringsFitness[i];
+            while (targetInFlight[nextTarget])
+                nextTarget = (nextTarget + 1) % numberOfIndividuals;
+            unsigned i = nextTarget;
+            nextTarget = (nextTarget + 1) % numberOfIndividuals;
+            launched++;
 
-            //Save the successful CR and F values
-            SSFF.push_back(FF[i]);
-            SSCR.push_back(CR[i]);
+            cauchy_distribution<double> cauchy(JADE_mu_ff, 0.1);
+            normal_distribution<double> gaussian(JADE_mu_cr, 0.1);
+
+            do
+            {
+                FF[s] = cauchy(engine);
+            } while (FF[s] <= 0.0);
+            if (FF[s] > 1.0) FF[s] = 1.0;
+
+            CR[s] = gaussian(engine);
+            if (CR[s] < 0.0) CR[s] = 0.0;
+            if (CR[s] > 1.0) CR[s] = 1.0;
+
+            if (!createTrial(i, FF[s], CR[s], offspring(s)))
+                continue;
+
+            if (budget.reserve(1) == 0)
+            {
+                numOfTrials = launched;
+                break;
+            }
+
+            freeSlots.pop_back();
+            trialTarget[s] = i;
+            targetInFlight[i] = true;
+            fillCandidate(offspring(s), &candidatesInFlight[(size_t)s * D]);
+            inFlight++;
+
+            const double *x = &candidatesInFlight[(size_t)s * D];
+            CCOptimizer.pool->submit([this, &CCOptimizer, s, x]()
+            {
+                double f;
+                CCOptimizer.computeFitnessValues(x, 1, &f);
+                completions.push(s, f);
+            });
         }
-    }
 
-    //Update mu_CR and mu_F based on the successful CRs and Fs
-	
-    if (SSCR.size())
-    {
-        //Update the mu_CR values
-        double mean_cr = 0.0;
+        if (inFlight == 0)
+            break;
 
-        for (unsigned int i = 0; i < SSCR.size(); i++)
-            mean_cr += SSCR[i];
+        //sleep until the next evaluation completes
+        CompletionQueue::Completion c;
+        completions.wait(c);
 
-        mean_cr = mean_cr / ((double)SSCR.size());
-        JADE_mu_cr = (1 - decomposer.CCOptimizer.JADE_c) * JADE_mu_cr + decomposer.CCOptimizer.JADE_c * mean_cr;
+        inFlight--;
+        freeSlots.push_back(c.slot);
+        nfe++;
+        budget.commit(eOffspring, 1, subcomponent);
 
-        //Update the mu_F value
-        double mean_ff = 0.0;
-        double t1 = 0.0;
-        double t2 = 0.0;
+        unsigned i = trialTarget[c.slot];
+        targetInFlight[i] = false;
+        addElementToArchive(offspring(c.slot), c.fitness);
 
-        for (unsigned int i = 0; i < SSFF.size(); i++)
+        if (c.fitness <= parentsFitness[i])
         {
-            t1 += SSFF[i] * SSFF[i];
-            t2 += SSFF[i];
-        }
+            copy(offspring(c.slot), offspring(c.slot) + dimension, parent(i));
+            parentsFitness[i] = c.fitness;
+            parentHasTrueFitness[i] = true;
+            parentIsStale[i] = false;
 
-        mean_ff = t1 / t2;
+            //the Lehmer mean of a single F value is F itself
+            JADE_mu_cr = (1 - CCOptimizer.JADE_c) * JADE_mu_cr + CCOptimizer.JADE_c * CR[c.slot];
+            JADE_mu_ff = (1 - CCOptimizer.JADE_c) * JADE_mu_ff + CCOptimizer.JADE_c * FF[c.slot];
 
-        //Lehmer mean
-        JADE_mu_ff = (1 - decomposer.CCOptimizer.JADE_c) * JADE_mu_ff + decomposer.CCOptimizer.JADE_c * mean_ff;
+            sortPopulation(parentsFitness, sortIndex);
+        }
     }
-}
 
+    updateIndexOfBest();
+}
 
 
 //******************************************************************************************/
@@ -743,34 +865,54 @@ void JADE::setParendouble(vector<double> &fitnessValues)
 //
 //
 //******************************************************************************************/
-void JADE::evaluateOffsprings(vector<bool> &toEvaluate, vector<bool> &hasTrueFitness)
+void JADE::evaluateOffsprings()
 {
-    //use real fitness function
-    for (unsigned d = 0; d < decomposer.CCOptimizer.problemDimension; ++d)
-        xp[d] = decomposer.contextVector[d];
+    EvaluationBudget &budget = decomposer->CCOptimizer.budget;
+
+    unsigned numToEvaluate = 0;
+    for (unsigned i = 0; i < numberOfParents; i++)
+        if (toEvaluate[i])
+            numToEvaluate++;
+
+    unsigned granted = budget.reserve(numToEvaluate);
 
-    offspringsFitness.resize(offsprings.size());
+    batchFitness.resize(granted);
+    batchIndexes.clear();
 
-    for (unsigned i = 0; i < offsprings.size(); i++)
+    for (unsigned i = 0; i < numberOfParents; i++)
     {
         if ( !toEvaluate[i] )
         {
             offspringsFitness[i] = parentsFitness[i];
-            hasTrueFitness[i] = parentHasTrueFitness[i];
+            offspringHasTrueFitness[i] = parentHasTrueFitness[i];
             continue;
         }
 
-        for (unsigned ld = 0; ld < dimension; ld++)
-            xp[coordinates[ld]] = offsprings[i][ld];
+        //budget exhausted: the offspring cannot replace its parent
+        if (batchIndexes.size() == granted)
+        {
+            offspringsFitness[i] = std::numeric_limits<double>::infinity();
+            offspringHasTrueFitness[i] = true;
+            continue;
+        }
 
-        offspringsFitness[i] = decomposer.CCOptimizer.computeFitnessValue(xp);
-        nfe++;
-        hasTrueFitness[i] = true;
-        addElementToArchive(offsprings[i], offspringsFitness[i]);
+        batchIndexes.push_back(i);
+    }
+
+    //use real fitness function
+    decomposer->CCOptimizer.evaluateCandidates(granted, [this](size_t k, double *x) { fillCandidate(offspring(batchIndexes[k]), x); },
+                                              batchFitness.data(), false);
 
-        for (unsigned ld = 0; ld < dimension; ld++)
-            xp[coordinates[ld]] = decomposer.contextVector[coordinates[ld]];
+    for (unsigned k = 0; k < granted; k++)
+    {
+        unsigned i = batchIndexes[k];
+        offspringsFitness[i] = batchFitness[k];
+        offspringHasTrueFitness[i] = true;
+        addElementToArchive(offspring(i), offspringsFitness[i]);
     }
+
+    nfe += granted;
+    budget.commit(eOffspring, granted, subcomponent);
 }
 
 
@@ -779,50 +921,160 @@ void JADE::evaluateOffsprings(vector<bool> &toEvaluate, vector<bool> &hasTrueFit
 //
 //
 //******************************************************************************************/
-int JADE::evaluateParents()
+int JADE::evaluateParents(typeOfEvaluation type)
 {
+    EvaluationBudget &budget = decomposer->CCOptimizer.budget;
+    unsigned granted = budget.reserve(numberOfParents);
+
+    batchFitness.resize(granted);
+
     //use real fitness function
-    for (unsigned d = 0; d < decomposer.CCOptimizer.problemDimension; ++d)
-        xp[d] = decomposer.contextVector[d];
+    decomposer->CCOptimizer.evaluateCandidates(granted, [this](size_t i, double *x) { fillCandidate(parent(i), x); }, batchFitness.data(), false);
+    budget.commit(type, granted, subcomponent);
+
+    setParentsFitness(batchFitness.data(), granted);
 
-    parentsFitness.resize(parents.size());
+    return granted;
+}
 
-    for (unsigned i = 0; i < parents.size(); i++)
+
+//******************************************************************************************/
+//
+// Assign the exact fitness of the first n parents; the others, which could not be evaluated
+// because of the budget, will be replaced by any evaluated offspring
+//
+//******************************************************************************************/
+void JADE::setParentsFitness(const double *f, unsigned n)
+{
+    parentsFitness.resize(numberOfParents);
+
+    for (unsigned i = 0; i < numberOfParents; i++)
     {
-        for (unsigned ld = 0; ld < dimension; ld++)
-            xp[coordinates[ld]] = parents[i][ld];
+        parentIsStale[i] = false;
+        if (i >= n)
+        {
+            parentsFitness[i] = std::numeric_limits<double>::infinity();
+            parentHasTrueFitness[i] = false;
+            continue;
+        }
 
-        parentsFitness[i] = decomposer.CCOptimizer.computeFitnessValue(xp);
-        nfe++;
+        parentsFitness[i] = f[i];
         parentHasTrueFitness[i] = true;
-        addElementToArchive(parents[i], parentsFitness[i]);
-
-        for (unsigned ld = 0; ld < dimension; ld++)
-            xp[coordinates[ld]] = decomposer.contextVector[coordinates[ld]];
+        addElementToArchive(parent(i), parentsFitness[i]);
     }
 
+    nfe += n;
+
+    updateIndexOfBest();
+}
+
+
+//******************************************************************************************/
+//
+// Assign the exact fitness of parent i, evaluated by the caller
+//
+//******************************************************************************************/
+void JADE::setParentFitness(unsigned i, double f)
+{
+    parentsFitness[i] = f;
+    parentHasTrueFitness[i] = true;
+    parentIsStale[i] = false;
+    addElementToArchive(parent(i), f);
+
+    nfe++;
+
     updateIndexOfBest();
+}
+
+
+//******************************************************************************************/
+//
+// After a change of the context vector without re-evaluation: the parents keep their fitness,
+// which only ranks them until they are evaluated or replaced
+//
+//******************************************************************************************/
+void JADE::markParentsStale()
+{
+    for (unsigned i = 0; i < numberOfParents; i++)
+    {
+        parentHasTrueFitness[i] = false;
+        parentIsStale[i] = true;
+    }
 
-    return parents.size();
+    updateIndexOfBest();
 }
 
 
+
 //******************************************************************************************/
 //
+// After a regrouping without re-evaluation: the parents keep the fitness carried over from the
+// previous grouping, which only ranks them until they are evaluated or replaced
 //
+//******************************************************************************************/
+void JADE::setStaleParentsFitness(vector<double> &fitnessValues)
+{
+    for (unsigned i = 0; i < numberOfParents; i++)
+    {
+        parentsFitness[i] = fitnessValues[i];
+        parentHasTrueFitness[i] = false;
+        parentIsStale[i] = true;
+    }
+
+    updateIndexOfBest();
+}
+
+
+//******************************************************************************************/
+//
+// Lazy re-evaluation of the stale parents: the best parent guides the mutation and becomes the
+// collaborator, so it is evaluated, and the next best with it, as long as its fitness is stale
 //
 //******************************************************************************************/
-double JADE::calculateFitnessValue(vector<double> &p, bool updateArchive)
+void JADE::evaluateStaleBest()
 {
-    for (unsigned d = 0; d < decomposer.CCOptimizer.problemDimension; ++d)
-        xp[d] = decomposer.contextVector[d];
+    updateIndexOfBest();
+    while (parentIsStale[indexOfBest] && !decomposer->CCOptimizer.budget.exhausted())
+    {
+        parentsFitness[indexOfBest] = calculateFitnessValue(parent(indexOfBest), true, eRegrouping);
+        parentHasTrueFitness[indexOfBest] = true;
+        parentIsStale[indexOfBest] = false;
+        updateIndexOfBest();
+    }
+}
 
+
+//******************************************************************************************/
+//
+// Write in x the context vector with the coordinates of this subcomponent replaced by p
+//
+//******************************************************************************************/
+void JADE::fillCandidate(const double *p, double *x)
+{
+    copy(decomposer->contextVector.begin(), decomposer->contextVector.end(), x);
     for (unsigned ld = 0; ld < coordinates.size(); ld++)
-        xp[coordinates[ld]] = p[ld];
+        x[coordinates[ld]] = p[ld];
+}
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+double JADE::calculateFitnessValue(const double *p, bool updateArchive, typeOfEvaluation type)
+{
+    EvaluationBudget &budget = decomposer->CCOptimizer.budget;
+    if (budget.reserve(1) == 0)
+        return std::numeric_limits<double>::infinity();
+
+    candidate.resize(decomposer->CCOptimizer.problemDimension);
+    fillCandidate(p, &candidate[0]);
 
-    double f = decomposer.CCOptimizer.computeFitnessValue(xp);
+    double f = decomposer->CCOptimizer.computeFitnessValue(candidate);
 
     nfe++;
+    budget.commit(type, 1, subcomponent);
 
     if ( updateArchive )
         addElementToArchive(p, f);
@@ -908,7 +1160,7 @@ void JADE::optimizeGPParameters()
     }
 
     for (int i = 0; i < np; ++i)
-        gpPars[i] = (gpPars_l[i] + gpPars_u[i])*unifRandom(decomposer.eng);
+        gpPars[i] = (gpPars_l[i] + gpPars_u[i])*unifRandom(engine);
 
     for (int i = 0; i < np; ++i)
         xc(i, 0) = gpPars[i];
@@ -940,7 +1192,7 @@ void JADE::optimizeGPParameters()
 void JADE::updateIndexOfBest()
 {
     besdouble = std::numeric_limits<double>::infinity();
-    for (unsigned i = 0; i < parents.size(); ++i)
+    for (unsigned i = 0; i < numberOfParents; ++i)
         if (parentsFitness[i] < besdouble)
         {
             indexOfBest = i;
@@ -966,8 +1218,12 @@ void JADE::emptyArchive()
 //
 //
 //******************************************************************************************/
-void JADE::addElementToArchive(vector<double> &individual, double trueFitness)
+void JADE::addElementToArchive(const double *individual, double trueFitness)
 {
+    //the archive only feeds the surrogates
+    if (sType == sNone)
+        return;
+
     //check for duplicates
     for (auto it = archive->begin(); it != archive->end(); ++it)
     {
@@ -980,7 +1236,7 @@ void JADE::addElementToArchive(vector<double> &individual, double trueFitness)
         }
     }
 
-    archive->push_back(Pattern(individual, trueFitness));
+    archive->push_back(Pattern(individual, dimension, trueFitness));
 }
 
 
@@ -989,15 +1245,15 @@ void JADE::addElementToArchive(vector<double> &individual, double trueFitness)
 //
 //
 //******************************************************************************************/
-double JADE::calculateSurrogateFitnessValue(vector<double> &p, typeOfSurrogate sType, bool &isTrueFitness)
+double JADE::calculateSurrogateFitnessValue(const double *p, typeOfSurrogate sType, bool &isTrueFitness)
 {
     isTrueFitness = false;
 
     //Avoid using the surrogate if already converged
-    if (fabs(decomposer.CCOptimizer.globalBesdouble - decomposer.CCOptimizer.optimum) <1.0E-16)
+    if (fabs(decomposer->CCOptimizer.globalBesdouble - decomposer->CCOptimizer.optimum) <1.0E-16)
     {
         isTrueFitness = true;
-		cout << "Already converged" << endl;
+		*decomposer->CCOptimizer.log << "Already converged" << endl;
         return calculateFitnessValue(p);
     }
 
@@ -1007,34 +1263,27 @@ double JADE::calculateSurrogateFitnessValue(vector<double> &p, typeOfSurrogate s
     {
         if (surrogateIsValid && sType == sGP)
         {
-            double *x;
-            x = new double[p.size()];
-            for (unsigned ld = 0; ld < coordinates.size(); ld++)
-                x[ld] = -1.0 + 2.0*(p[ld] - minCoordInArchive[ld]) / (maxCoordInArchive[ld] - minCoordInArchive[ld]);
+            double *x = &surrogateInput[0];
+            kernels.normalize(dimension, p, &minCoordInArchive[0], &maxCoordInArchive[0], x);
 
             double f = currentMin + gp->f(x)*(currentMax - currentMin);
 
-            delete[] x;
-
             return f;
 
         }
         else if (surrogateIsValid && sType == sRBFN)
         {
-            vector<double> x(p.size());
-            for (unsigned ld = 0; ld < coordinates.size(); ld++)
-                x[ld] = -1.0 + 2.0*(p[ld] - minCoordInArchive[ld]) / (maxCoordInArchive[ld] - minCoordInArchive[ld]);
+            kernels.normalize(dimension, p, &minCoordInArchive[0], &maxCoordInArchive[0], &surrogateInput[0]);
 
-            double f = currentMin + rbfn->predictValue(x)*(currentMax - currentMin);
+            double f = currentMin + rbfn->predictValue(surrogateInput)*(currentMax - currentMin);
 
             return f;
         }
 		else if (surrogateIsValid && sType == sSVR)
 		{
 			sample_type x;
-			x.set_size(p.size());
-			for (unsigned ld = 0; ld < coordinates.size(); ld++)
-				x(ld, 0) = -1.0 + 2.0*(p[ld] - minCoordInArchive[ld]) / (maxCoordInArchive[ld] - minCoordInArchive[ld]);
+			x.set_size(dimension);
+			kernels.normalize(dimension, p, &minCoordInArchive[0], &maxCoordInArchive[0], &x(0, 0));
 
 			double f = currentMin + svr(x)*(currentMax - currentMin);
 
@@ -1043,7 +1292,7 @@ double JADE::calculateSurrogateFitnessValue(vector<double> &p, typeOfSurrogate s
         else
         {
             isTrueFitness = true;
-			cout << "Surrogate not valid: using true fitness" << endl;
+			*decomposer->CCOptimizer.log << "Surrogate not valid: using true fitness" << endl;
             return calculateFitnessValue(p);
         }
     }
@@ -1056,20 +1305,28 @@ double JADE::calculateSurrogateFitnessValue(vector<double> &p, typeOfSurrogate s
             return calculateFitnessValue(p);
         }
 
-        vector< vector<Pattern>::iterator > sortArchive;
-        for (auto it = archive->begin(); it != archive->end(); ++it)
+        //the temporaries of a prediction are given back on return, as many offspring are predicted
+        //in a generation
+        ScratchArena::Scope scope(scratch);
+
+        Pattern **sortArchive = scratch.allocate<Pattern*>(archive->size());
+        const double **archivePoints = scratch.allocate<const double*>(archive->size());
+        double *distances = scratch.allocate<double>(archive->size());
+        for (unsigned i = 0; i < archive->size(); ++i)
+            archivePoints[i] = &(*archive)[i].point[0];
+        kernels.squaredDistances(dimension, p, archivePoints, archive->size(), distances);
+        for (unsigned i = 0; i < archive->size(); ++i)
         {
-            double d = 0;
-            for (unsigned ld = 0; ld < coordinates.size(); ld++)
-                d += (p[ld] - it->point[ld])*(p[ld] - it->point[ld]);
-            it->dist = d;
-            sortArchive.push_back(it);
+            Pattern &pattern = (*archive)[i];
+            pattern.dist = distances[i];
+            sortArchive[i] = &pattern;
         }
 
-        sort(sortArchive.begin(), sortArchive.end(), doComparePatterns());
+        sort(sortArchive, sortArchive + archive->size(), doComparePatterns());
 
-        vector< vector<double> > points;
-        vector<double> values;
+        //design of the regression, one row of dimension values per point
+        double *points = scratch.allocate<double>((size_t)minNumberOfPatterns * dimension);
+        double *values = scratch.allocate<double>(minNumberOfPatterns);
 
         currentMin = currentMax = sortArchive[0]->fitness;
         for (unsigned ld = 0; ld < coordinates.size(); ld++)
@@ -1096,27 +1353,18 @@ double JADE::calculateSurrogateFitnessValue(vector<double> &p, typeOfSurrogate s
 
         for (int i = 0; i < minNumberOfPatterns; ++i)
         {
-            vector<double> x(sortArchive[i]->point.size());
-            for (unsigned ld = 0; ld < coordinates.size(); ld++)
-            {
-                x[ld] = -1.0 + 2.0*(sortArchive[i]->point[ld] - minCoordInArchive[ld]) / (maxCoordInArchive[ld] - minCoordInArchive[ld]);
-            }
-            points.push_back(x);
+            kernels.normalize(dimension, &sortArchive[i]->point[0], &minCoordInArchive[0], &maxCoordInArchive[0], points + (size_t)i * dimension);
 
-            double f = (sortArchive[i]->fitness - currentMin) / (currentMax - currentMin);
-
-            values.push_back(f);
+            values[i] = (sortArchive[i]->fitness - currentMin) / (currentMax - currentMin);
         }
 
         qr->setData(points, values);
 
-        vector<double> x(p.size());
-        for (unsigned ld = 0; ld < coordinates.size(); ld++)
-            x[ld] = -1.0 + 2.0*(p[ld] - minCoordInArchive[ld]) / (maxCoordInArchive[ld] - minCoordInArchive[ld]);
+        kernels.normalize(dimension, p, &minCoordInArchive[0], &maxCoordInArchive[0], &surrogateInput[0]);
 
         startTime = clock();
 
-        double f = qr->evaluate(x);
+        double f = qr->evaluate(surrogateInput);
 
         return currentMin + f*(currentMax - currentMin);
     }
@@ -1133,20 +1381,15 @@ double JADE::calculateSurrogateFitnessValue(vector<double> &p, typeOfSurrogate s
 //
 //
 //******************************************************************************************/
-double JADE::calculateGPSurrogatePredictionVariance(vector<double> &p)
+double JADE::calculateGPSurrogatePredictionVariance(const double *p)
 {
     if (surrogateIsValid)
     {
-        double *x;
-        clock_t startTime = clock();
-        x = new double[p.size()];
-        for (unsigned ld = 0; ld < coordinates.size(); ld++)
-            x[ld] = -1.0 + 2.0*(p[ld] - minCoordInArchive[ld]) / (maxCoordInArchive[ld] - minCoordInArchive[ld]);
+        double *x = &surrogateInput[0];
+        kernels.normalize(dimension, p, &minCoordInArchive[0], &maxCoordInArchive[0], x);
 
         double v = currentMin + gp->var(x)*(currentMax - currentMin);
 
-        delete[] x;
-
         return v;
     }
     else return 0;
@@ -1162,7 +1405,7 @@ void JADE::findSVRparameters(std::vector<sample_type> &samples, std::vector<doub
 
 	std::vector<int> ind;
 	for (int i = 0; i < samples.size(); ++i) ind.push_back(i);
-	std::random_shuffle(ind.begin(), ind.end());
+	std::shuffle(ind.begin(), ind.end(), engine);
 
 	std::vector<sample_type> cvSamples[2];
 	std::vector<double> cvTargets[2];
@@ -1242,7 +1485,7 @@ void JADE::trainGlobalSurrogate()
     }
 
     //Avoid using the surrogate if already converged
-    if (fabs(decomposer.CCOptimizer.globalBesdouble - decomposer.CCOptimizer.optimum)<1.0E-16)
+    if (fabs(decomposer->CCOptimizer.globalBesdouble - decomposer->CCOptimizer.optimum)<1.0E-16)
     {
         surrogateIsValid = false;
         return;
@@ -1285,15 +1528,10 @@ void JADE::trainGlobalSurrogate()
         gp->clear_sampleset();
         for (int i = startIndex; i < archive->size(); ++i)
         {
-            double *x = new double[coordinates.size()];
-            for (unsigned ld = 0; ld < coordinates.size(); ld++)
-            {
-                x[ld] = -1.0 + 2.0*((*archive)[i].point[ld] - minCoordInArchive[ld]) / (maxCoordInArchive[ld] - minCoordInArchive[ld]);
-            }
+            double *x = &surrogateInput[0];
+            kernels.normalize(dimension, &(*archive)[i].point[0], &minCoordInArchive[0], &maxCoordInArchive[0], x);
 
             gp->add_pattern(x, ((*archive)[i].fitness - currentMin) / (currentMax - currentMin));
-
-            delete[] x;
         }
 
         optimizeGPParameters();
@@ -1301,22 +1539,20 @@ void JADE::trainGlobalSurrogate()
     else if (sType == sRBFN)
     {
         rbfn->reset();
+        rbfn->seed(engine());
 
         unsigned numPatterns = archive->size() - startIndex;
-        vector<int> indexes(numPatterns);
+        int *indexes = scratch.allocate<int>(numPatterns);
         for (int i = 0; i < numPatterns; ++i)
             indexes[i] = i;
 
-        random_shuffle(indexes.begin(), indexes.end());
+        shuffle(indexes, indexes + numPatterns, engine);
         bool hold_out = false;
         for (int ii = 0; ii<numPatterns; ++ii)
         {
             int i = startIndex + indexes[ii];
             vector<double> x(coordinates.size());
-            for (unsigned ld = 0; ld < coordinates.size(); ld++)
-            {
-                x[ld] = -1.0 + 2.0*((*archive)[i].point[ld] - minCoordInArchive[ld]) / (maxCoordInArchive[ld] - minCoordInArchive[ld]);
-            }
+            kernels.normalize(dimension, &(*archive)[i].point[0], &minCoordInArchive[0], &maxCoordInArchive[0], &x[0]);
 
             //double f = -1.0 + 2.0*((*archive)[i].fitness - currentMin) / (currentMax - currentMin);
             double f = ((*archive)[i].fitness - currentMin) / (currentMax - currentMin);
@@ -1349,10 +1585,7 @@ void JADE::trainGlobalSurrogate()
 		{
 			sample_type x;
 			x.set_size(coordinates.size());
-			for (unsigned ld = 0; ld < coordinates.size(); ld++)
-			{
-				x(ld, 0) = -1.0 + 2.0*((*archive)[i].point[ld] - minCoordInArchive[ld]) / (maxCoordInArchive[ld] - minCoordInArchive[ld]);
-			}
+			kernels.normalize(dimension, &(*archive)[i].point[0], &minCoordInArchive[0], &maxCoordInArchive[0], &x(0, 0));
 
 			samples.push_back(x);
 			targets.push_back(((*archive)[i].fitness - currentMin) / (currentMax - currentMin));
@@ -1404,22 +1637,91 @@ void JADE::optimize(int iterations)
     if ( qr )
         qr->reset();
 
+    if (decomposer->CCOptimizer.generationMode == gSteadyState)
+    {
+        //same number of trials as the generational mode
+        steadyStateOptimize(iterations * numberOfIndividuals);
+        ite = iterations;
+        return;
+    }
+
+    //the instance of the generation is chosen once for all the iterations
+    void (JADE::*generationOfThisType)() = selectGeneration();
+
     for (ite = 0; ite < iterations; ++ite)
     {
-        if ( decomposer.CCOptimizer.numberOfEvaluations + this->nfe >= decomposer.CCOptimizer.maxNumberOfEvaluations )
+        if ( decomposer->CCOptimizer.budget.exhausted() )
             break;
 
-        if (sType == sNone)
-            update();
-        else if (sType == sGP || sType == sQPA || sType==sRBFN || sType==sSVR )
-        {
-            SAUpdate(sType);
-        }
-        else
-        {
-            cerr << "Unknown type of surrogate" << endl;
-            exit(1);
-        }
+        (this->*generationOfThisType)();
     }
     updateIndexOfBest();
+
+    decomposer->CCOptimizer.scratchUsage.collect(scratch);
+}
+
+
+
+//******************************************************************************************/
+//
+// The usual sizes of subcomponents are those of SubcomponentKernels::forSize
+//
+//******************************************************************************************/
+template<class Surrogate, class Mutation>
+void (JADE::*JADE::selectGeneration(unsigned size))()
+{
+    switch (size)
+    {
+    case 5:   return &JADE::generation<Surrogate, Mutation, 5>;
+    case 10:  return &JADE::generation<Surrogate, Mutation, 10>;
+    case 20:  return &JADE::generation<Surrogate, Mutation, 20>;
+    case 25:  return &JADE::generation<Surrogate, Mutation, 25>;
+    case 50:  return &JADE::generation<Surrogate, Mutation, 50>;
+    case 100: return &JADE::generation<Surrogate, Mutation, 100>;
+    default:  return &JADE::generation<Surrogate, Mutation, 0>;
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+template<class Surrogate>
+void (JADE::*JADE::selectGeneration(int mutationStrategy))()
+{
+    if (mutationStrategy == 2)
+        return selectGeneration<Surrogate, RandToPBest>(dimension);
+    return selectGeneration<Surrogate, CurrentToPBest>(dimension);
+}
+
+
+
+//******************************************************************************************/
+//
+// Instance of the generation for the surrogate, the mutation strategy and the size of this optimizer
+//
+//******************************************************************************************/
+void (JADE::*JADE::selectGeneration())()
+{
+    int mutationStrategy = decomposer->CCOptimizer.JADE_mutationStrategy;
+
+    switch (sType)
+    {
+    case sNone:
+        return selectGeneration< SurrogatePolicy<sNone> >(mutationStrategy);
+    case sGP:
+        return selectGeneration< SurrogatePolicy<sGP> >(mutationStrategy);
+    case sQPA:
+        return selectGeneration< SurrogatePolicy<sQPA> >(mutationStrategy);
+    case sRBFN:
+        return selectGeneration< SurrogatePolicy<sRBFN> >(mutationStrategy);
+    case sSVR:
+        return selectGeneration< SurrogatePolicy<sSVR> >(mutationStrategy);
+    }
+
+    cerr << "Unknown type of surrogate" << endl;
+    exit(1);
 }
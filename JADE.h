@@ -37,6 +37,13 @@
 #include "cg.h"
 #include "gp_utils.h"
 #include "rprop.h"
+#include "EvaluationBudget.h"
+#include "CompletionQueue.h"
+#include "Checkpoint.h"
+#include "AlignedAllocator.h"
+#include "PhiloxEngine.h"
+#include "TrialKernel.h"
+#include "ScratchArena.h"
 
 class Decomposer;
 
@@ -45,19 +52,57 @@ using namespace std;
 
 typedef dlib::matrix<double, 0, 1> column_vector;
 
+typedef PhiloxEngine RandomEngine;
+
 typedef enum { sNone = 0, sGP, sQPA, sRBFN, sSVR} typeOfSurrogate;
 
+///Surrogate policy of JADE::generation: whether the offspring are pre-screened by a surrogate,
+///which is trained on the whole archive (global) and provides the variance of its predictions
+template<typeOfSurrogate S>
+struct SurrogatePolicy
+{
+	static const typeOfSurrogate type = S;
+	static const bool assisted = S != sNone;
+	static const bool global = S == sGP || S == sRBFN || S == sSVR;
+	static const bool variance = S == sGP;
+};
+
+///Mutation policies of JADE::createTrial: operands of the mutant base + F (pbest - base) + F (d1 - d2)
+///built from the target xi and the random parents x1, x2, x3
+struct CurrentToPBest
+{
+	static void operands(const double *xi, const double *x1, const double *x2, const double *,
+	                     const double *&base, const double *&d1, const double *&d2)
+	{
+		base = xi;
+		d1 = x1;
+		d2 = x2;
+	}
+};
+
+struct RandToPBest
+{
+	static void operands(const double *, const double *x1, const double *x2, const double *x3,
+	                     const double *&base, const double *&d1, const double *&d2)
+	{
+		base = x1;
+		d1 = x2;
+		d2 = x3;
+	}
+};
+
 struct Pattern {
 	vector<double> point;
 	double fitness;
 	double dist;
 	Pattern(vector<double> & p, double f) : point(p), fitness(f) {};
+	Pattern(const double *p, unsigned n, double f) : point(p, p + n), fitness(f) {};
 };
 
 
 class JADE
 {
-	Decomposer &decomposer;
+	Decomposer *decomposer;
 
 	typedef dlib::matrix<double, 0, 1> sample_type;
 	typedef dlib::radial_basis_kernel<sample_type> kernel_type;
@@ -90,46 +135,69 @@ class JADE
 	{
 		doComparePatterns(){};
 
-		bool operator()(const vector<Pattern>::iterator & i1, const vector<Pattern>::iterator & i2)
+		bool operator()(const Pattern *p1, const Pattern *p2)
 		{
-			return i1->dist < i2->dist;
+			return p1->dist < p2->dist;
 		}
 	};
 
 public:
 	JADE(unsigned _dimension, unsigned _numberOfIndividuals, Decomposer &_group, typeOfSurrogate _sType);
 	~JADE();
-	void setCoordinates(vector<unsigned> &_coordinates);
+	void reset(Decomposer &_group);
+	///coordinates must point into the coordinates of the decomposer (see blockStart)
 	void setCoordinates(unsigned *coordinates, unsigned numOfCoordinates);
-	void SAUpdate(typeOfSurrogate sType);	
-	void update();
+	void gatherBounds();
+	template<class Surrogate, class Mutation, unsigned N> void generation();
+	template<class Surrogate, class Mutation> void (JADE::*selectGeneration(unsigned size))();
+	template<class Surrogate> void (JADE::*selectGeneration(int mutationStrategy))();
+	void (JADE::*selectGeneration())();
+	template<class Mutation, unsigned N> bool createTrial(unsigned i, double F, double &Cr, double *child);
+	bool createTrial(unsigned i, double F, double &Cr, double *child);
+	void steadyStateOptimize(unsigned numOfTrials);
 	void updateContextVector();
 	void updateContextVector(vector<double> &cv, vector<unsigned> &coords, unsigned &vi);
 	void sortPopulation(vector<double> &fitness, vector<int> &sortIndex);
-	void evaluateOffsprings(vector<bool> &toEvaluate, vector<bool> &hasTrueFitness);	
-	int evaluateParents();	
-	double calculateFitnessValue(vector<double> &p, bool updateArchive=true);
-	double calculateSurrogateFitnessValue(vector<double> &p, typeOfSurrogate sType, bool &offspringHasTrueFitness);	
-	double calculateGPSurrogatePredictionVariance(vector<double> &p);	
+	void evaluateOffsprings();
+	int evaluateParents(typeOfEvaluation type=eParents);	
+	void setParentsFitness(const double *f, unsigned n);
+	void setParentFitness(unsigned i, double f);
+	void setStaleParentsFitness(vector<double> &fitnessValues);
+	void markParentsStale();
+	void evaluateStaleBest();
+	void fillCandidate(const double *p, double *x);
+	double calculateFitnessValue(const double *p, bool updateArchive=true, typeOfEvaluation type=eOffspring);
+	double calculateSurrogateFitnessValue(const double *p, typeOfSurrogate sType, bool &offspringHasTrueFitness);
+	double calculateGPSurrogatePredictionVariance(const double *p);
 	void optimize(int iterations);
 	void updateIndexOfBest();
 	void loadIndividuals(vector< vector<double> > &population);
 	void updateIndividuals(vector< vector<double> > &population);
 	void storeIndividuals(vector< vector<double> > &population);
 	void setParendouble(vector<double> &fitnessValues);
-	void addElementToArchive(vector<double> &individual, double trueFitness);
+	void addElementToArchive(const double *individual, double trueFitness);
 	void createGP();	
 	void optimizeGPParameters();
 	void trainGlobalSurrogate();	
 	void emptyArchive();
-	vector<double> &getCollaborator();	
+	double *getCollaborator();
 	double GPLogLikelihood(const column_vector &p);
 	double GPLogLikelihoodD(double *p);
 	const column_vector GPLogLikelihoodGradient(const column_vector &p);
 	void findSVRparameters(std::vector<sample_type> &samples, std::vector<double> &targets, double &gamma, double &c);
+	void setStream(uint64_t seed, uint64_t stream);
+	void saveState(CheckpointWriter &w);
+	void loadState(CheckpointReader &r);
 
+	///exact fitness evaluations performed by this optimizer (the global count is kept by CCDE::budget)
 	unsigned nfe;
+	///position of this optimizer among the subcomponents of its decomposer, under which its
+	///evaluations are recorded by the budget (see Decomposer::acquireOptimizer)
+	unsigned subcomponent;
 	vector<unsigned> coordinates;	
+	///position of the first coordinate in Decomposer::coordinates, where the variables of this
+	///subcomponent start in each row of Decomposer::population
+	unsigned blockStart;
 	unsigned int dimension;
 	unsigned int numGPPars;
 	vector<double> gpPars;
@@ -143,20 +211,58 @@ public:
 	double	JADE_mu_cr;
 	double	JADE_mu_ff;
 
-	///array containing the positions of all individuals
-	vector< vector<double> > parents;
-	vector< vector<double> > offsprings;
+	///positions of the parents and of the offspring: numberOfIndividuals rows of rowStride values,
+	///dimension rounded up so that every row starts on a 32-byte boundary. The buffers are sized
+	///once in the constructor and a generation allocates nothing; the steady-state mode uses the
+	///rows of the offspring as its slots
+	typedef vector< double, AlignedAllocator<double> > PopulationBuffer;
+	PopulationBuffer parentsBuffer;
+	PopulationBuffer offspringsBuffer;
+	unsigned rowStride;
+	double *parent(unsigned i) { return &parentsBuffer[(size_t)i * rowStride]; }
+	double *offspring(unsigned i) { return &offspringsBuffer[(size_t)i * rowStride]; }
+
+	///parents in use, at most numberOfIndividuals (see loadIndividuals)
+	unsigned numberOfParents;
+
 	vector<int> sortIndex;
 	vector<double> FF;
 	vector<double> CR;
 	vector<double> SSFF;  // successful F values
 	vector<double> SSCR;  // successful CR values 
-	vector<int> binaryVector;
+	///uniform numbers of the binomial crossover of a trial, and bounds of the coordinates of the
+	///subcomponent (see trialKernel)
+	vector<double> crossoverStream;
+	vector<double> lowerBlock;
+	vector<double> upperBlock;
+
+	///loops over the coordinates, compiled for the size of this subcomponent when it is a usual one
+	SubcomponentKernels kernels;
+
+	///a point normalized for the surrogates (see SubcomponentKernels::normalize)
+	vector<double> surrogateInput;
+
+	///temporaries of the surrogates, released at the beginning of each generation
+	ScratchArena scratch;
 	vector< double > parentsFitness;///array containing the current fitness of all particles 
 	vector< bool > parentHasTrueFitness;
+	///parents whose fitness was carried over from the previous grouping and not recomputed since
+	vector< bool > parentIsStale;
 	vector< double > offspringsFitness;
 	vector< double > offspringsVariance;
 
+	///per-offspring flags of a generation: the trial differs from its target, its fitness is
+	///exact, it has been evaluated (surrogate-assisted update); and the order of the offspring
+	///by fitness
+	vector< char > toEvaluate;
+	vector< char > offspringHasTrueFitness;
+	vector< char > alreadyEvaluated;
+	vector< int > offspringOrder;
+
+	///steady-state mode: targets with a trial in flight, and free slots
+	vector< char > targetInFlight;
+	vector< unsigned > freeSlots;
+
 	double besdouble;
 
 	///array containing the index of the best position attained so far
@@ -164,11 +270,21 @@ public:
 
 	unsigned numberOfIndividuals;
 
-	///buffer
-	vector< double > xp;
+	///buffers for batch evaluations: fitness and offspring index of each candidate (the full-dimensional
+	///candidates are built in buffers shared by the optimizers of the same thread, see CCDE::evaluateCandidates)
+	vector< double > batchFitness;
+	vector< unsigned > batchIndexes;
+
+	///steady-state mode: target of the trial in each slot (the trial is in offspring(slot)) and results of the evaluations in flight
+	vector< unsigned > trialTarget;
+	CompletionQueue completions;
 
 	uniform_real_distribution<double> unifRandom;
 
+	///pseudorandom generator of this optimizer: its own stream (see Decomposer::acquireOptimizer), so
+	///that the results do not depend on the order in which the optimizers run
+	RandomEngine engine;
+
 	bool internalArchive;
 	vector< Pattern > *archive;
 		
@@ -0,0 +1,90 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : JADEPool.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "JADEPool.h"
+
+using namespace std;
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+JADEPool::JADEPool()
+{
+    constructed = 0;
+    recycled = 0;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+JADEPool::~JADEPool()
+{
+    for (map< Key, vector<JADE*> >::iterator p = idle.begin(); p != idle.end(); ++p)
+        for (unsigned i = 0; i < p->second.size(); ++i)
+            delete p->second[i];
+}
+
+
+
+//******************************************************************************************/
+//
+// The reset draws from the generator of the decomposer like the constructor, so that a recycled
+// optimizer leaves the search unchanged
+//
+//******************************************************************************************/
+JADE *JADEPool::acquire(unsigned dimension, unsigned numberOfIndividuals, Decomposer &decomposer, typeOfSurrogate sType)
+{
+    JADE *optimizer = NULL;
+    {
+        lock_guard<mutex> lock(idleMutex);
+        vector<JADE*> &available = idle[Key(dimension, numberOfIndividuals, (int)sType)];
+        if (available.size())
+        {
+            optimizer = available.back();
+            available.pop_back();
+            recycled++;
+        }
+        else
+            constructed++;
+    }
+
+    if (optimizer == NULL)
+        return new JADE(dimension, numberOfIndividuals, decomposer, sType);
+
+    optimizer->reset(decomposer);
+    return optimizer;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void JADEPool::release(JADE *optimizer)
+{
+    if (optimizer == NULL)
+        return;
+
+    lock_guard<mutex> lock(idleMutex);
+    idle[Key(optimizer->dimension, optimizer->numberOfIndividuals, (int)optimizer->sType)].push_back(optimizer);
+}
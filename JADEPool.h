@@ -0,0 +1,54 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : JADEPool.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <vector>
+#include <map>
+#include <tuple>
+#include <mutex>
+#include "JADE.h"
+
+using namespace std;
+
+
+/**
+	@brief Optimizers released by the decomposers, kept for reuse instead of being destroyed.
+	Each JADE owns buffers, an archive and the objects of its surrogate, all sized by the dimension of
+	its subcomponent; an optimizer with the same dimension, number of individuals and type of surrogate
+	is taken back from the pool and reset (see JADE::reset), so that new decompositions, new islands
+	and new repetitions do not allocate them again.
+	acquire and release may be called by several threads.
+*/
+class JADEPool
+{
+    typedef tuple<unsigned, unsigned, int> Key;
+
+    map< Key, vector<JADE*> > idle;
+    mutex idleMutex;
+
+public:
+    ///Optimizers constructed and taken back from the pool so far
+    unsigned constructed;
+    unsigned recycled;
+
+    JADEPool();
+    ~JADEPool();
+
+    ///An optimizer in the state of a newly constructed one, working for the given decomposer
+    JADE *acquire(unsigned dimension, unsigned numberOfIndividuals, Decomposer &decomposer, typeOfSurrogate sType);
+
+    ///Give back an optimizer no longer used; it is destroyed with the pool
+    void release(JADE *optimizer);
+};
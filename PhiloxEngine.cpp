@@ -0,0 +1,197 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : PhiloxEngine.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "PhiloxEngine.h"
+
+using namespace std;
+
+
+//******************************************************************************************/
+//
+// Ten rounds of Philox4x32 on the counter c under the key k
+//
+//******************************************************************************************/
+static void philox4x32(uint32_t c[4], const uint32_t k[2])
+{
+    const uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+    const uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+
+    uint32_t k0 = k[0], k1 = k[1];
+    for (unsigned round = 0; round < 10; ++round)
+    {
+        uint64_t p0 = (uint64_t)M0 * c[0];
+        uint64_t p1 = (uint64_t)M1 * c[2];
+
+        uint32_t c0 = (uint32_t)(p1 >> 32) ^ c[1] ^ k0;
+        uint32_t c2 = (uint32_t)(p0 >> 32) ^ c[3] ^ k1;
+        c[1] = (uint32_t)p1;
+        c[3] = (uint32_t)p0;
+        c[0] = c0;
+        c[2] = c2;
+
+        k0 += W0;
+        k1 += W1;
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+PhiloxEngine::PhiloxEngine(uint64_t _seed, uint64_t _stream)
+{
+    seed(_seed, _stream);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void PhiloxEngine::seed(uint64_t _seed, uint64_t _stream)
+{
+    key[0] = (uint32_t)_seed;
+    key[1] = (uint32_t)(_seed >> 32);
+    stream = _stream;
+    counter = 0;
+    position = 4;
+}
+
+
+
+//******************************************************************************************/
+//
+// The counter words are (n low, n high, stream low, stream high)
+//
+//******************************************************************************************/
+void PhiloxEngine::nextBlock()
+{
+    block[0] = (uint32_t)counter;
+    block[1] = (uint32_t)(counter >> 32);
+    block[2] = (uint32_t)stream;
+    block[3] = (uint32_t)(stream >> 32);
+    philox4x32(block, key);
+
+    counter++;
+    position = 0;
+}
+
+
+
+//******************************************************************************************/
+//
+// Whole blocks are skipped without being generated
+//
+//******************************************************************************************/
+void PhiloxEngine::discard(uint64_t n)
+{
+    while (n > 0 && position < 4)
+    {
+        position++;
+        n--;
+    }
+
+    if (n == 0)
+        return;
+
+    counter += (n - 1) / 4;
+    nextBlock();
+    position = (unsigned)((n - 1) % 4) + 1;
+}
+
+
+
+//******************************************************************************************/
+//
+// Same arithmetic as generate_canonical<double, 53> on a 32-bit generator: the first number
+// gives the low bits and the second one the high bits
+//
+//******************************************************************************************/
+void PhiloxEngine::fill(double *u, size_t n)
+{
+    const double two32 = 4294967296.0;
+    const double two64 = two32 * two32;
+    const double belowOne = 1.0 - 1.0 / 9007199254740992.0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double low = (*this)();
+        double high = (*this)();
+        double x = (low + high * two32) / two64;
+        u[i] = x < 1.0 ? x : belowOne;
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+bool operator==(const PhiloxEngine &a, const PhiloxEngine &b)
+{
+    //engines at the end of a block and at the beginning of the next one are in the same state
+    uint64_t ia = a.counter * 4 - (4 - a.position);
+    uint64_t ib = b.counter * 4 - (4 - b.position);
+    return a.key[0] == b.key[0] && a.key[1] == b.key[1] && a.stream == b.stream && ia == ib;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+ostream &operator<<(ostream &os, const PhiloxEngine &e)
+{
+    return os << e.key[0] << ' ' << e.key[1] << ' ' << e.stream << ' ' << e.counter << ' ' << e.position;
+}
+
+
+
+//******************************************************************************************/
+//
+// The current block is regenerated from the counter
+//
+//******************************************************************************************/
+istream &operator>>(istream &is, PhiloxEngine &e)
+{
+    uint32_t k0, k1;
+    uint64_t stream, counter;
+    unsigned position;
+    if (!(is >> k0 >> k1 >> stream >> counter >> position) || position > 4 || (position < 4 && counter == 0))
+    {
+        is.setstate(ios::failbit);
+        return is;
+    }
+
+    e.seed(((uint64_t)k1 << 32) | k0, stream);
+    if (position < 4)
+    {
+        e.counter = counter - 1;
+        e.nextBlock();
+        e.position = position;
+    }
+    else
+        e.counter = counter;
+
+    return is;
+}
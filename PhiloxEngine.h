@@ -0,0 +1,77 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : PhiloxEngine.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+
+using namespace std;
+
+
+/**
+	@brief Counter-based pseudorandom generator Philox4x32-10 (Salmon et al., 'Parallel random
+	numbers: as easy as 1, 2, 3', SC 2011).
+
+	The n-th block of four 32-bit numbers is a bijection of the counter (stream, n) under the key
+	given by the seed, so every (seed, stream) pair is an independent sequence that needs no
+	state besides its position: the generators of a run (decomposers, optimizers, surrogate models)
+	are assigned their own streams instead of sharing one engine or seeding each other.
+
+	It is a uniform random bit generator, usable with the distributions and the algorithms of
+	<random> and <algorithm>; fill draws many uniform numbers at once, identical to as many calls of
+	uniform_real_distribution<double>(0, 1).
+*/
+class PhiloxEngine
+{
+public:
+    typedef uint32_t result_type;
+    static const uint64_t default_seed = 5489u;
+
+    explicit PhiloxEngine(uint64_t _seed = default_seed, uint64_t _stream = 0);
+
+    ///Restart the stream of the given seed
+    void seed(uint64_t _seed = default_seed, uint64_t _stream = 0);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+    result_type operator()()
+    {
+        if (position == 4)
+            nextBlock();
+        return block[position++];
+    }
+
+    void discard(uint64_t n);
+
+    ///n uniform numbers in [0,1), each made of two consecutive 32-bit numbers
+    void fill(double *u, size_t n);
+
+    friend bool operator==(const PhiloxEngine &a, const PhiloxEngine &b);
+    friend bool operator!=(const PhiloxEngine &a, const PhiloxEngine &b) { return !(a == b); }
+    friend ostream &operator<<(ostream &os, const PhiloxEngine &e);
+    friend istream &operator>>(istream &is, PhiloxEngine &e);
+
+private:
+    uint32_t key[2];
+    uint64_t stream;
+    ///index of the next block to generate, and position in the current block (4: exhausted)
+    uint64_t counter;
+    unsigned position;
+    uint32_t block[4];
+
+    void nextBlock();
+};
@@ -0,0 +1,217 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : ScratchArena.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+
+#include "ScratchArena.h"
+#include <new>
+#include <algorithm>
+#include <iomanip>
+
+using namespace std;
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+ScratchArena::Block ScratchArena::newBlock(size_t size)
+{
+    Block b;
+    b.memory = (char*)::operator new(size + alignment);
+    b.data = (char*)(((size_t)b.memory + alignment - 1) & ~(alignment - 1));
+    b.size = size;
+
+    heapAllocations++;
+    size_t total = 0;
+    for (unsigned i = 0; i < blocks.size(); ++i)
+        total += blocks[i].size;
+    peakBytes = max(peakBytes, total + size);
+
+    return b;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+ScratchArena::ScratchArena(size_t initialSize)
+{
+    generations = 0;
+    allocations = 0;
+    heapAllocations = 0;
+    peakBytes = 0;
+
+    blocks.push_back(newBlock(initialSize));
+    current = 0;
+    offset = 0;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+ScratchArena::~ScratchArena()
+{
+    for (unsigned i = 0; i < blocks.size(); ++i)
+        ::operator delete(blocks[i].memory);
+}
+
+
+
+//******************************************************************************************/
+//
+// The next block is reused if a rewind left it behind and it is large enough, otherwise a block
+// twice as large as the last one (or as the request) is taken from the heap
+//
+//******************************************************************************************/
+void *ScratchArena::allocateInNewBlock(size_t bytes)
+{
+    ++current;
+    if (current == blocks.size() || blocks[current].size < bytes)
+        blocks.insert(blocks.begin() + current, newBlock(max(2 * blocks.back().size, bytes)));
+
+    offset = bytes;
+    return blocks[current].data;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+ScratchArena::Mark ScratchArena::mark() const
+{
+    Mark m = { current, offset };
+    return m;
+}
+
+
+
+//******************************************************************************************/
+//
+// The blocks after the mark are kept for the next allocations
+//
+//******************************************************************************************/
+void ScratchArena::rewind(const Mark &m)
+{
+    current = m.block;
+    offset = m.offset;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void ScratchArena::reset()
+{
+    generations++;
+
+    if (blocks.size() > 1)
+    {
+        size_t total = 0;
+        for (unsigned i = 0; i < blocks.size(); ++i)
+        {
+            total += blocks[i].size;
+            ::operator delete(blocks[i].memory);
+        }
+        blocks.clear();
+        blocks.push_back(newBlock(total));
+    }
+
+    current = 0;
+    offset = 0;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+ScratchUsage::ScratchUsage()
+{
+    clear();
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void ScratchUsage::clear()
+{
+    generations = 0;
+    allocations = 0;
+    heapAllocations = 0;
+    peakBytes = 0;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void ScratchUsage::collect(ScratchArena &arena)
+{
+    generations += arena.generations;
+    allocations += arena.allocations;
+    heapAllocations += arena.heapAllocations;
+
+    size_t peak = peakBytes.load();
+    while (arena.peakBytes > peak && !peakBytes.compare_exchange_weak(peak, arena.peakBytes))
+        ;
+
+    arena.generations = 0;
+    arena.allocations = 0;
+    arena.heapAllocations = 0;
+    arena.peakBytes = 0;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void ScratchUsage::print(ostream &os) const
+{
+    uint64_t g = generations.load();
+    ios::fmtflags flags = os.flags();
+    streamsize precision = os.precision();
+    os << "Scratch arenas: " << g << " generations  allocations=" << allocations.load();
+    if (g)
+        os << " (" << fixed << setprecision(1) << (double)allocations.load() / g << " per generation)";
+    os << "  heap blocks=" << heapAllocations.load()
+       << "  peak=" << peakBytes.load() << " bytes" << endl;
+    os.flags(flags);
+    os.precision(precision);
+}
@@ -0,0 +1,130 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : ScratchArena.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+using namespace std;
+
+
+/**
+	@brief Bump allocator for the temporaries of a generation of JADE (the sorted archive, the
+	design points of QPA, the shuffled patterns of the RBFN). An allocation only moves an offset
+	within a block taken from the heap; nothing is freed individually, and reset releases
+	everything at the generation boundary. When a generation needed more than the first block,
+	reset merges the blocks into one large enough, so that after the first generations the arena
+	takes nothing more from the heap.
+	Each JADE owns its arena and runs on one thread at a time, so the arena is not synchronized.
+*/
+class ScratchArena
+{
+    ///memory is the address returned by operator new, data the first cache line within it
+    struct Block
+    {
+        char *memory;
+        char *data;
+        size_t size;
+    };
+
+    vector<Block> blocks;
+    size_t current;
+    size_t offset;
+
+    Block newBlock(size_t size);
+    void *allocateInNewBlock(size_t bytes);
+
+    ScratchArena(const ScratchArena &);
+    ScratchArena &operator=(const ScratchArena &);
+
+public:
+    ///Every allocation starts on a cache line
+    static const size_t alignment = 64;
+
+    ///Position of the arena, to give back the temporaries of a single call (see Scope)
+    struct Mark
+    {
+        size_t block;
+        size_t offset;
+    };
+
+    ///Rewinds the arena to where it was at construction, when the scope of a call ends
+    class Scope
+    {
+        ScratchArena &arena;
+        Mark mark;
+
+    public:
+        Scope(ScratchArena &_arena) : arena(_arena), mark(_arena.mark()) {}
+        ~Scope() { arena.rewind(mark); }
+    };
+
+    ///Usage since the counters were last collected (see ScratchUsage::collect): generations,
+    ///allocations served, blocks taken from the heap, largest total size of the blocks
+    uint64_t generations;
+    uint64_t allocations;
+    uint64_t heapAllocations;
+    size_t peakBytes;
+
+    ScratchArena(size_t initialSize = 16 * 1024);
+    ~ScratchArena();
+
+    ///Storage for n objects of type T, which must not need a destructor
+    template<class T> T *allocate(size_t n)
+    {
+        size_t bytes = n * sizeof(T);
+        allocations++;
+        size_t start = (offset + alignment - 1) & ~(alignment - 1);
+        if (start + bytes <= blocks[current].size)
+        {
+            offset = start + bytes;
+            return (T*)(blocks[current].data + start);
+        }
+        return (T*)allocateInNewBlock(bytes);
+    }
+
+    Mark mark() const;
+    void rewind(const Mark &m);
+
+    ///Generation boundary: all the temporaries are released
+    void reset();
+};
+
+
+/**
+	@brief Usage of the scratch arenas of all the optimizers of a run, collected by each optimizer
+	at the end of its iterations. The counters are lock-free.
+*/
+class ScratchUsage
+{
+    atomic<uint64_t> generations;
+    atomic<uint64_t> allocations;
+    atomic<uint64_t> heapAllocations;
+    atomic<size_t> peakBytes;
+
+public:
+    ScratchUsage();
+
+    void clear();
+
+    ///Add the counters of arena, which are then cleared
+    void collect(ScratchArena &arena);
+
+    void print(ostream &os) const;
+};
@@ -0,0 +1,76 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : ShiftedElliptic.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "ShiftedElliptic.h"
+#include <random>
+#include <cmath>
+
+using namespace std;
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+ShiftedElliptic::ShiftedElliptic(unsigned _dimension)
+{
+    dimension = _dimension;
+    minX = -100;
+    maxX = 100;
+    ID = 16;
+
+    mt19937 eng(16);
+    uniform_real_distribution<double> unifRandom(-80, 80);
+
+    shift.resize(dimension);
+    weight.resize(dimension);
+    for (unsigned i = 0; i < dimension; ++i)
+    {
+        shift[i] = unifRandom(eng);
+        weight[i] = dimension > 1 ? pow(10.0, 6.0 * i / (dimension - 1)) : 1.0;
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+double ShiftedElliptic::compute(double *x)
+{
+    double result = 0;
+    for (unsigned i = 0; i < dimension; ++i)
+    {
+        double z = x[i] - shift[i];
+        result += weight[i] * z * z;
+    }
+    return result;
+}
+
+
+
+//******************************************************************************************/
+//
+// A single group of separable variables
+//
+//******************************************************************************************/
+void ShiftedElliptic::createIdealGroups()
+{
+    idealGroups.assign(1, vector<unsigned>(dimension));
+    for (unsigned i = 0; i < dimension; ++i)
+        idealGroups[0][i] = i;
+}
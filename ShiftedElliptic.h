@@ -0,0 +1,45 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : ShiftedElliptic.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <vector>
+#include "BatchFitness.h"
+
+using namespace std;
+
+
+/**
+	@brief Shifted elliptic function of any dimension, f(x) = sum_i 10^(6 i/(D-1)) (x_i - o_i)^2 on
+	[-100, 100]^D, with the shift o drawn once from a fixed seed.
+	It is the base function of CEC2013 f1 without its transformations, and serves to measure the
+	memory and the cycle time of the optimizer when D grows beyond the 1000 variables of CEC2013.
+	The function is fully separable.
+*/
+class ShiftedElliptic : public BatchFitness
+{
+    vector<double> shift;
+    vector<double> weight;
+
+public:
+    ShiftedElliptic(unsigned _dimension);
+
+    virtual double compute(double *x);
+    virtual double compute(vector<double> x) { return compute(&x[0]); }
+    virtual void createIdealGroups();
+    virtual double getMinX() { return minX; }
+    virtual double getMaxX() { return maxX; }
+    virtual unsigned getID() { return ID; }
+    virtual unsigned getDimension() { return dimension; }
+};
@@ -0,0 +1,73 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : SobolEngine.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "PhiloxEngine.h"
+
+using namespace std;
+
+
+/**
+	@brief Streaming generator of Sobol points in [0,1)^dimension, in the Gray-code order of
+	Antonov and Saleev: each point is obtained from the previous one with a single XOR per
+	coordinate, and is written directly where the caller wants it.
+
+	The direction numbers of the first maxDimension coordinates (the table of Bratley and Fox
+	extended by Joe and Kuo, formerly read from sobol.dat) are built once per process from a
+	compact table compiled into the program. Points have 32 bits, and without scrambling are the
+	points of the former i8_sobol.
+
+	The sequence has no more than maxDimension coordinates: reusing the direction numbers would
+	make coordinate i + maxDimension a copy of coordinate i, even under a digital shift. The
+	coordinates beyond maxDimension are therefore uniform pseudorandom numbers, the n-th point
+	drawing them from a fixed position of a Philox stream so that seek still works.
+
+	With a scrambling seed, every coordinate is XORed with its own random 32-bit digital shift:
+	the points keep the equidistribution properties of the sequence, but engines with different
+	seeds (e.g. the subcomponents of a decomposer) no longer produce the same points. The seed
+	also selects the stream of the coordinates beyond maxDimension.
+*/
+class SobolEngine
+{
+    unsigned dimension;
+    uint64_t index;
+    vector<uint32_t> state;
+    vector<uint32_t> shift;
+
+    ///generator of the coordinates beyond maxDimension, and its seed
+    PhiloxEngine uniform;
+    uint64_t uniformSeed;
+
+public:
+    ///Coordinates of the Sobol sequence; the others are uniform pseudorandom numbers
+    static const unsigned maxDimension = 1111;
+
+    SobolEngine(unsigned _dimension);
+
+    ///Digital shifts drawn from seed (the engine starts unscrambled)
+    void scramble(uint64_t seed);
+
+    ///Move to the n-th point of the sequence
+    void seek(uint64_t n);
+
+    ///Write the current point in x[0..dimension-1] and move to the next one
+    void next(double *x);
+
+    ///Number of initial points skipped by the former Sobol initialization of the decomposer, which
+    ///avoids the poorly distributed first points in low dimension (tau_sobol)
+    static unsigned skipFor(unsigned dimension);
+};
@@ -0,0 +1,151 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : ThreadPool.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "ThreadPool.h"
+
+using namespace std;
+
+static thread_local int currentWorkerIndex = -1;
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+ThreadPool::ThreadPool(unsigned numThreads) : pending(0), stopping(false)
+{
+    if (numThreads == 0)
+        numThreads = max(1u, thread::hardware_concurrency());
+
+    for (unsigned i = 0; i < numThreads; ++i)
+        workers.push_back(thread(&ThreadPool::workerLoop, this, (int)i));
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+ThreadPool::~ThreadPool()
+{
+    {
+        unique_lock<mutex> lock(queueMutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+
+    for (unsigned i = 0; i < workers.size(); ++i)
+        workers[i].join();
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+int ThreadPool::workerIndex()
+{
+    return currentWorkerIndex;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void ThreadPool::workerLoop(int index)
+{
+    currentWorkerIndex = index;
+
+    for (;;)
+    {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(queueMutex);
+            taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty())
+                return;
+            task = tasks.front();
+            tasks.pop_front();
+        }
+
+        task();
+
+        {
+            unique_lock<mutex> lock(queueMutex);
+            if (--pending == 0)
+                allDone.notify_all();
+        }
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void ThreadPool::parallelFor(unsigned n, const function<void(unsigned)> &task)
+{
+    if (n == 0)
+        return;
+
+    {
+        unique_lock<mutex> lock(queueMutex);
+        for (unsigned i = 0; i < n; ++i)
+            tasks.push_back([&task, i] { task(i); });
+        pending += n;
+    }
+    taskAvailable.notify_all();
+
+    wait();
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void ThreadPool::submit(const function<void()> &task)
+{
+    {
+        unique_lock<mutex> lock(queueMutex);
+        tasks.push_back(task);
+        ++pending;
+    }
+    taskAvailable.notify_one();
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void ThreadPool::wait()
+{
+    unique_lock<mutex> lock(queueMutex);
+    allDone.wait(lock, [this] { return pending == 0; });
+}
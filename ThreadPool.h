@@ -0,0 +1,66 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : ThreadPool.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 16, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+using namespace std;
+
+
+/**
+	@brief Fixed-size pool of worker threads.
+	Tasks are indexed: parallelFor(n, task) runs task(0..n-1) on the workers and returns when all of them are done.
+	Each worker knows its own index (see workerIndex()), which allows the caller to keep per-worker resources
+	such as a private copy of the objective function.
+*/
+class ThreadPool
+{
+    vector<thread> workers;
+    deque< function<void()> > tasks;
+    mutex queueMutex;
+    condition_variable taskAvailable;
+    condition_variable allDone;
+    unsigned pending;
+    bool stopping;
+
+    void workerLoop(int index);
+
+public:
+    ///Create the pool with the specified number of workers (0 -> number of hardware threads)
+    ThreadPool(unsigned numThreads);
+
+    ///Join all the workers
+    ~ThreadPool();
+
+    ///Run task(i) for i in [0, n) and wait for completion
+    void parallelFor(unsigned n, const function<void(unsigned)> &task);
+
+    ///Queue a task and return immediately; the caller is notified of its completion by the task itself
+    void submit(const function<void()> &task);
+
+    ///Wait for the completion of all the submitted tasks
+    void wait();
+
+    ///Number of workers
+    unsigned size() const { return workers.size(); }
+
+    ///Index of the calling worker in [0, size()), or -1 if called from a thread not owned by a pool
+    static int workerIndex();
+};
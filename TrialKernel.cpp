@@ -0,0 +1,102 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : TrialKernel.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "TrialKernel.h"
+
+
+//******************************************************************************************/
+//
+// N is the number of coordinates, or 0 if given by n
+//
+//******************************************************************************************/
+template<unsigned N>
+static void squaredDistancesOfSize(unsigned n, const double *p, const double *const *points, unsigned count, double *distances)
+{
+    const unsigned size = N ? N : n;
+    for (unsigned k = 0; k < count; ++k)
+    {
+        const double *q = points[k];
+        double d = 0;
+        for (unsigned j = 0; j < size; ++j)
+            d += (p[j] - q[j]) * (p[j] - q[j]);
+        distances[k] = d;
+    }
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+template<unsigned N>
+static void normalizeOfSize(unsigned n, const double *p, const double *lower, const double *upper, double *x)
+{
+    const unsigned size = N ? N : n;
+    for (unsigned j = 0; j < size; ++j)
+        x[j] = -1.0 + 2.0*(p[j] - lower[j]) / (upper[j] - lower[j]);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+unsigned trialKernel(unsigned n, double F, double Cr, const double *target, const double *base,
+                     const double *pbest, const double *r1, const double *r2, const double *u,
+                     const double *lower, const double *upper, double *child, bool &outOfBounds)
+{
+    return trialOfSize<0>(n, F, Cr, target, base, pbest, r1, r2, u, lower, upper, child, outOfBounds);
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+template<unsigned N>
+static SubcomponentKernels kernelsOfSize()
+{
+    SubcomponentKernels k;
+    k.trial = &trialOfSize<N>;
+    k.squaredDistances = &squaredDistancesOfSize<N>;
+    k.normalize = &normalizeOfSize<N>;
+    return k;
+}
+
+
+
+//******************************************************************************************/
+//
+// The sizes must be those of JADE::selectGeneration
+//
+//******************************************************************************************/
+SubcomponentKernels SubcomponentKernels::forSize(unsigned n)
+{
+    switch (n)
+    {
+    case 5:   return kernelsOfSize<5>();
+    case 10:  return kernelsOfSize<10>();
+    case 20:  return kernelsOfSize<20>();
+    case 25:  return kernelsOfSize<25>();
+    case 50:  return kernelsOfSize<50>();
+    case 100: return kernelsOfSize<100>();
+    default:  return kernelsOfSize<0>();
+    }
+}
@@ -0,0 +1,120 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : TrialKernel.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRIAL_KERNEL_SSE2
+#include <emmintrin.h>
+#endif
+
+
+/**
+	@brief Mutation and binomial crossover of one JADE trial, in a single branch-free pass over its
+	coordinates (two at a time with SSE2, which every x64 compiler provides).
+
+	The mutant is base + F (pbest - base) + F (r1 - r2): current-to-pbest/1 with base = target,
+	rand-to-pbest/1 with base = the first random parent. Coordinate j of the child is taken from the
+	mutant when u[j] < Cr and from the target otherwise, so the caller forces the mutated coordinate
+	of the binomial crossover by writing a negative value in u. The random numbers are drawn by the
+	caller before the pass.
+
+	Returns the number of coordinates taken from the mutant; outOfBounds is set if any coordinate of
+	the child lies outside [lower, upper], in which case the caller repairs them (rarely needed, and
+	the only part of a trial that draws random numbers on demand).
+
+	N is the number of coordinates, or 0 if given by n. The instances for a fixed N have a constant
+	trip count and are defined here so that they can be inlined into the generation compiled for
+	that size (see JADE::selectGeneration). The vector and the scalar loops perform the same
+	operations in the same order, so the child does not depend on the path taken.
+*/
+template<unsigned N>
+inline unsigned trialOfSize(unsigned n, double F, double Cr, const double *target, const double *base,
+                            const double *pbest, const double *r1, const double *r2, const double *u,
+                            const double *lower, const double *upper, double *child, bool &outOfBounds)
+{
+    const unsigned size = N ? N : n;
+    unsigned taken = 0;
+    unsigned j = 0;
+    bool violation = false;
+
+#ifdef TRIAL_KERNEL_SSE2
+    const __m128d vF = _mm_set1_pd(F);
+    const __m128d vCr = _mm_set1_pd(Cr);
+    __m128d violations = _mm_setzero_pd();
+
+    for (; j + 2 <= size; j += 2)
+    {
+        __m128d b = _mm_loadu_pd(base + j);
+        __m128d mutant = _mm_add_pd(_mm_add_pd(b, _mm_mul_pd(vF, _mm_sub_pd(_mm_loadu_pd(pbest + j), b))),
+                                    _mm_mul_pd(vF, _mm_sub_pd(_mm_loadu_pd(r1 + j), _mm_loadu_pd(r2 + j))));
+
+        __m128d take = _mm_cmplt_pd(_mm_loadu_pd(u + j), vCr);
+        __m128d c = _mm_or_pd(_mm_and_pd(take, mutant), _mm_andnot_pd(take, _mm_loadu_pd(target + j)));
+        _mm_storeu_pd(child + j, c);
+
+        violations = _mm_or_pd(violations, _mm_or_pd(_mm_cmplt_pd(c, _mm_loadu_pd(lower + j)),
+                                                     _mm_cmpgt_pd(c, _mm_loadu_pd(upper + j))));
+
+        int mask = _mm_movemask_pd(take);
+        taken += (mask & 1) + (mask >> 1);
+    }
+
+    violation = _mm_movemask_pd(violations) != 0;
+#endif
+
+    for (; j < size; ++j)
+    {
+        double mutant = base[j] + F * (pbest[j] - base[j]) + F * (r1[j] - r2[j]);
+        bool take = u[j] < Cr;
+        double c = take ? mutant : target[j];
+        child[j] = c;
+
+        violation |= c < lower[j] || c > upper[j];
+        taken += take;
+    }
+
+    outOfBounds = violation;
+    return taken;
+}
+
+
+///Trial of any number of coordinates
+unsigned trialKernel(unsigned n, double F, double Cr, const double *target, const double *base,
+                     const double *pbest, const double *r1, const double *r2, const double *u,
+                     const double *lower, const double *upper, double *child, bool &outOfBounds);
+
+
+/**
+	@brief The loops over the coordinates of a subcomponent: the trial kernel, the squared distances
+	from a point to the patterns of the archive, used to find the nearest ones, and the
+	normalization of a point to [-1,1] within the bounds of the archive, which feeds the surrogates.
+
+	forSize returns the instances compiled for a fixed number of coordinates when n is one of the
+	usual sizes of subcomponents (5, 10, 20, 25, 50, 100), so that their loops have a constant trip
+	count and can be unrolled; for other sizes it returns the instances with a run-time count. All
+	the instances perform the same operations in the same order, so they give the same results.
+	The calls through these pointers are not inlined: the generational JADE calls trialOfSize
+	directly instead, and squaredDistances takes all the patterns of a prediction at once.
+*/
+struct SubcomponentKernels
+{
+    unsigned (*trial)(unsigned n, double F, double Cr, const double *target, const double *base,
+                      const double *pbest, const double *r1, const double *r2, const double *u,
+                      const double *lower, const double *upper, double *child, bool &outOfBounds);
+    void (*squaredDistances)(unsigned n, const double *p, const double *const *points, unsigned count, double *distances);
+    void (*normalize)(unsigned n, const double *p, const double *lower, const double *upper, double *x);
+
+    static SubcomponentKernels forSize(unsigned n);
+};
@@ -0,0 +1,40 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : Benchmarks.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "Benchmarks.h"
+#include <iostream>
+#include <cstdlib>
+
+using namespace std;
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void runBenchmark(const string &name)
+{
+    if (name == "trial")
+        benchTrialKernel();
+    else if (name == "generation")
+        benchGeneration();
+    else if (name == "scaling")
+        benchScaling();
+    else
+    {
+        cerr << "unknown benchmark " << name << " [trial, generation, scaling]" << endl;
+        exit(1);
+    }
+}
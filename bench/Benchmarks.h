@@ -0,0 +1,45 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : Benchmarks.h
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#pragma once
+
+#include <string>
+#include <chrono>
+
+using namespace std;
+
+
+/**
+	@brief Microbenchmarks of the optimizer, run with --bench <name> instead of an optimization.
+	Each one prints a table on the standard output:
+
+	    trial       the JADE trial kernel against the former scalar loop, for subcomponents of 5 to
+	                100 variables
+	    generation  the time per JADE generation, without a surrogate and with QPA, for
+	                subcomponents of 5 to 100 variables
+	    scaling     the peak memory and the time of a cycle for 10^3 to 10^6 variables, against
+	                the memory model of CCDE
+*/
+void runBenchmark(const string &name);
+
+void benchTrialKernel();
+void benchGeneration();
+void benchScaling();
+
+
+///Seconds elapsed since start
+inline double secondsSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
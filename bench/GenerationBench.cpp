@@ -0,0 +1,95 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : GenerationBench.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "Benchmarks.h"
+#include "../CCDE.h"
+#include "../ShiftedElliptic.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+
+static const unsigned problemDimension = 100;
+static const unsigned individuals = 10;
+static const unsigned iterationsPerCycle = 10;
+static const unsigned repetitions = 5;
+
+
+//******************************************************************************************/
+//
+// Wall time per generation of a complete optimization with subcomponents of the given size,
+// including the share of each generation in the merge and the regrouping at the end of the
+// cycles. The generations are counted from the allocation recorded in the convergence. The
+// best of some repetitions is kept, the objective function being cheap enough for the
+// generation to dominate
+//
+//******************************************************************************************/
+static double secondsPerGeneration(typeOfSurrogate sType, unsigned size, unsigned evaluations)
+{
+    double best = 0;
+    for (unsigned r = 0; r < repetitions; ++r)
+    {
+        ShiftedElliptic f(problemDimension);
+        ostringstream report;
+        vector<ConvPlotPoint> convergence;
+
+        CCDE ccde;
+        ccde.setLog(report);
+        ccde.optimize(&f, evaluations, size, individuals, convergence, 1, sType, iterationsPerCycle);
+
+        double generations = 0;
+        for (unsigned c = 0; c < convergence.size(); ++c)
+            for (unsigned j = 0; j < convergence[c].generations.size(); ++j)
+                generations += convergence[c].generations[j];
+
+        double seconds = ccde.wallTime / generations;
+        if (r == 0 || seconds < best)
+            best = seconds;
+    }
+    return best;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void benchGeneration()
+{
+    const unsigned sizes[] = { 5, 10, 20, 25, 50, 100 };
+    const typeOfSurrogate surrogates[] = { sNone, sQPA };
+    const char *names[] = { "none", "QPA" };
+    const unsigned evaluations[] = { 300000, 30000 };
+
+    cout << "JADE generation, shifted elliptic of " << problemDimension << " variables, " << individuals
+         << " individuals, " << iterationsPerCycle << " generations per cycle" << endl;
+    cout << setw(6) << "size";
+    for (unsigned k = 0; k < 2; ++k)
+        cout << setw(12) << string(names[k]) + " us";
+    cout << endl;
+    cout << fixed << setprecision(2);
+
+    for (unsigned i = 0; i < 6; ++i)
+    {
+        cout << setw(6) << sizes[i];
+        for (unsigned k = 0; k < 2; ++k)
+            cout << setw(12) << secondsPerGeneration(surrogates[k], sizes[i], evaluations[k]) * 1e6 << flush;
+        cout << endl;
+    }
+}
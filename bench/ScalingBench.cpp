@@ -0,0 +1,147 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : ScalingBench.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "Benchmarks.h"
+#include "../CCDE.h"
+#include "../ShiftedElliptic.h"
+#include <iostream>
+#include <iomanip>
+#include <streambuf>
+#include <vector>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+
+static const unsigned numberOfSubcomponents = 100;
+static const unsigned individuals = 10;
+static const unsigned completeCycles = 3;
+
+
+//******************************************************************************************/
+//
+// Peak memory of the process, in MB
+//
+//******************************************************************************************/
+static double peakMemory()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize / 1048576.0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+#endif
+}
+
+
+
+/**
+	@brief Progress report of CCDE that records when each cycle ends, i.e. when a line beginning
+	with "Cycle=" is written, and discards the text.
+*/
+class CycleClock : public streambuf
+{
+    string line;
+
+protected:
+    virtual int overflow(int c)
+    {
+        if (c == '\n')
+        {
+            if (line.compare(0, 6, "Cycle=") == 0)
+                ends.push_back(chrono::steady_clock::now());
+            line.clear();
+        }
+        else if (c != EOF)
+            line += (char)c;
+        return c == EOF ? 0 : c;
+    }
+
+public:
+    vector<chrono::steady_clock::time_point> ends;
+};
+
+
+
+//******************************************************************************************/
+//
+// Peak memory and time of a cycle of the optimization of a shifted elliptic function of
+// dimension variables, decomposed in numberOfSubcomponents subcomponents. The budget allows the
+// initialization and a few more than completeCycles cycles; the time of a cycle is the mean of
+// the complete ones
+//
+//******************************************************************************************/
+static void benchDimension(unsigned dimension)
+{
+    unsigned size = dimension / numberOfSubcomponents;
+
+    //one generation per cycle, the merge of the collaborators and the re-evaluation of the
+    //parents after the random grouping
+    unsigned evaluationsPerCycle = numberOfSubcomponents * (2 * individuals + 1);
+    unsigned evaluations = individuals + (completeCycles + 1) * evaluationsPerCycle;
+
+    ShiftedElliptic f(dimension);
+    CycleClock clock;
+    ostream report(&clock);
+    vector<ConvPlotPoint> convergence;
+
+    CCDE ccde;
+    ccde.setLog(report);
+    ccde.optimize(&f, evaluations, size, individuals, convergence, 1, sNone, 1);
+
+    double cycleTime = 0;
+    unsigned cycles = min((unsigned)clock.ends.size() - 1, completeCycles);
+    for (unsigned c = 1; c <= cycles; ++c)
+        cycleTime += chrono::duration<double>(clock.ends[c] - clock.ends[c - 1]).count();
+    cycleTime /= cycles;
+
+    //peak of the memory model of CCDE, without the code and the objective function
+    double model = (4.0 * individuals + 18) * dimension * sizeof(double) / 1048576.0;
+
+    cout << setw(10) << dimension << setw(8) << size
+         << setprecision(1) << setw(12) << peakMemory() << setw(12) << model
+         << setprecision(3) << setw(12) << cycleTime << setw(14) << cycleTime / evaluationsPerCycle * 1e6 << endl;
+}
+
+
+
+//******************************************************************************************/
+//
+// The dimensions are taken in increasing order, so that the peak memory of the process is
+// that of the last one
+//
+//******************************************************************************************/
+void benchScaling()
+{
+    cout << "Shifted elliptic, " << numberOfSubcomponents << " subcomponents of " << individuals
+         << " individuals, no surrogate, one generation per cycle" << endl;
+    cout << setw(10) << "D" << setw(8) << "size" << setw(12) << "peak MB" << setw(12) << "model MB"
+         << setw(12) << "cycle s" << setw(14) << "us/eval" << endl;
+    cout << fixed;
+
+    benchDimension(1000);
+    benchDimension(10000);
+    benchDimension(100000);
+    benchDimension(1000000);
+}
@@ -0,0 +1,154 @@
+//============================================================================================
+// SACCJADE - Surrogate-Assisted Cooperative Coevolutionary version of JADE
+//============================================================================================
+// Name        : TrialKernelBench.cpp
+// Authors     : SACCJADE contributors (see the version history)
+// Created on  : Oct 17, 2026
+//
+// Extension of the original SACCJADE code, which is described in the following paper:
+//
+// De Falco, I., Della Cioppa, A., Trunfio, G.A.
+// 'Investigating Surrogate-assisted Cooperative Coevolution for Large-Scale Global Optimization',
+// submitted'
+//=============================================================================================
+
+#include "Benchmarks.h"
+#include "../TrialKernel.h"
+#include "../PhiloxEngine.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+
+static const unsigned numberOfParents = 10;
+static const double lowerLimit = -100;
+static const double upperLimit = 100;
+
+
+//******************************************************************************************/
+//
+// The trial of the former JADE::update: the mutation strategy is tested and the bounds are
+// checked for every coordinate, and the binomial crossover draws one random number per coordinate
+//
+//******************************************************************************************/
+static unsigned scalarTrial(unsigned n, int mutationStrategy, double F, double Cr, const double *xi,
+                            const double *xp, const double *x1, const double *x2, const double *x3,
+                            vector<double> &mutant, vector<char> &binaryVector, double *child,
+                            PhiloxEngine &engine, uniform_real_distribution<double> &unifRandom)
+{
+    for (unsigned j = 0; j < n; j++)
+    {
+        if (mutationStrategy == 1)
+            mutant[j] = xi[j] + F * (xp[j] - xi[j]) + F * (x1[j] - x2[j]);
+        else if (mutationStrategy == 2)
+            mutant[j] = x1[j] + F * (xp[j] - x1[j]) + F * (x2[j] - x3[j]);
+
+        if (mutant[j] < lowerLimit || mutant[j] > upperLimit)
+            mutant[j] = lowerLimit + unifRandom(engine) * (upperLimit - lowerLimit);
+    }
+
+    unsigned j_rnd = n * unifRandom(engine);
+    for (unsigned j = 0; j < n; j++)
+        binaryVector[j] = unifRandom(engine) < Cr || j == j_rnd;
+
+    unsigned tt = 0;
+    for (unsigned j = 0; j < n; j++)
+        tt += binaryVector[j];
+
+    for (unsigned j = 0; j < n; j++)
+        child[j] = binaryVector[j] ? mutant[j] : xi[j];
+
+    return tt;
+}
+
+
+
+//******************************************************************************************/
+//
+// Seconds per trial of each path, for subcomponents of N variables: the scalar loop, the kernel
+// called through SubcomponentKernels and the kernel inlined, as in JADE::createTrial. The random
+// numbers of the crossover are drawn in every path
+//
+//******************************************************************************************/
+template<unsigned N>
+static void benchSize()
+{
+    const unsigned trials = 20000000 / N;
+
+    PhiloxEngine engine(1);
+    uniform_real_distribution<double> unifRandom;
+
+    vector<double> parents((size_t)numberOfParents * N);
+    for (unsigned k = 0; k < parents.size(); ++k)
+        parents[k] = lowerLimit + unifRandom(engine) * (upperLimit - lowerLimit) / 2;
+    vector<double> lower(N, lowerLimit), upper(N, upperLimit);
+    vector<double> mutant(N), u(N), child(N);
+    vector<char> binaryVector(N);
+    SubcomponentKernels kernels = SubcomponentKernels::forSize(N);
+
+    const double F = 0.5, Cr = 0.5;
+    double checksum = 0;
+    bool outOfBounds;
+
+    auto parent = [&parents](unsigned i) { return &parents[(size_t)(i % numberOfParents) * N]; };
+
+    double seconds[3];
+    for (unsigned path = 0; path < 3; ++path)
+    {
+        engine.seed(2);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (unsigned t = 0; t < trials; ++t)
+        {
+            const double *xi = parent(t), *xp = parent(t + 1), *x1 = parent(t + 3), *x2 = parent(t + 5), *x3 = parent(t + 7);
+            unsigned tt;
+            if (path == 0)
+                tt = scalarTrial(N, 1, F, Cr, xi, xp, x1, x2, x3, mutant, binaryVector, &child[0], engine, unifRandom);
+            else
+            {
+                unsigned j_rnd = N * unifRandom(engine);
+                engine.fill(&u[0], N);
+                u[j_rnd] = -1.0;
+                if (path == 1)
+                    tt = kernels.trial(N, F, Cr, xi, xi, xp, x1, x2, &u[0], &lower[0], &upper[0], &child[0], outOfBounds);
+                else
+                    tt = trialOfSize<N>(N, F, Cr, xi, xi, xp, x1, x2, &u[0], &lower[0], &upper[0], &child[0], outOfBounds);
+            }
+            checksum += child[t % N] + tt;
+        }
+        seconds[path] = secondsSince(start) / trials;
+    }
+
+    cout << setw(6) << N
+         << setw(14) << seconds[0] * 1e9 << setw(14) << seconds[1] * 1e9 << setw(14) << seconds[2] * 1e9
+         << setw(10) << seconds[0] / seconds[1] << setw(10) << seconds[0] / seconds[2]
+         << "   (checksum " << checksum << ")" << endl;
+}
+
+
+
+//******************************************************************************************/
+//
+//
+//
+//******************************************************************************************/
+void benchTrialKernel()
+{
+#ifdef TRIAL_KERNEL_SSE2
+    cout << "Trial kernel with SSE2, current-to-pbest/1, Cr = F = 0.5" << endl;
+#else
+    cout << "Trial kernel without SSE2, current-to-pbest/1, Cr = F = 0.5" << endl;
+#endif
+    cout << setw(6) << "size" << setw(14) << "scalar ns" << setw(14) << "pointer ns" << setw(14) << "inlined ns"
+         << setw(10) << "speedup" << setw(10) << "inlined" << endl;
+    cout << fixed << setprecision(1);
+
+    benchSize<5>();
+    benchSize<10>();
+    benchSize<20>();
+    benchSize<25>();
+    benchSize<50>();
+    benchSize<100>();
+}
@@ -17,16 +17,24 @@
 
 #define _USE_MATH_DEFINES
 #include "CCDE.h"
+#include "ExperimentGrid.h"
+#include "bench/Benchmarks.h"
 #include "Benchmarks2013.h"
+#include "ShiftedElliptic.h"
 #include "Header.h"
 #include "tclap/CmdLine.h"
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <sstream>
 
 using namespace TCLAP;
 
 using namespace std;
 
-// create new object of class with default setting
-Fitness* generateFuncObj(int funcID)
+// create new object of class with default setting (the dimension only applies to f16, the
+// CEC2013 functions have their own)
+Fitness* generateFuncObj(int funcID, unsigned dimension)
 {
 	Fitness *fp = NULL;
 	using namespace CEC2013;
@@ -45,6 +53,7 @@ Fitness* generateFuncObj(int funcID)
 	else if (funcID == 13) fp = new F13();
 	else if (funcID == 14) fp = new F14();
 	else if (funcID == 15) fp = new F15();
+	else if (funcID == 16) fp = new ShiftedElliptic(dimension);
 	else
 	{
 		cerr << "Fail to locate Specified Function Index" << endl;
@@ -54,6 +63,40 @@ Fitness* generateFuncObj(int funcID)
 	return fp;
 }
 
+Fitness* generateFuncObj(int funcID)
+{
+	return generateFuncObj(funcID, 1000);
+}
+
+
+//******************************************************************************************/
+//
+// Fill fp->idealGroups for the decomposition given by the objective function. The CEC2013 classes
+// build them from their permutation and group sizes, which must be read before the first
+// evaluation; they do not initialize these for the functions without nonseparable groups
+// (f1-f3) or made of a single one (f12, f15), nor account for overlapping groups (f13, f14),
+// whose conforming subcomponents chain into a single nonseparable group
+//
+//******************************************************************************************/
+void createIdealGroups(Fitness *fp, int funcID)
+{
+	unsigned dimension = fp->getDimension();
+	vector<unsigned> all(dimension);
+	for (unsigned i = 0; i < dimension; ++i)
+		all[i] = i;
+
+	fp->idealGroups.clear();
+	if (funcID <= 3 || funcID == 16)
+		fp->idealGroups.push_back(all);
+	else if (funcID <= 11)
+		fp->createIdealGroups();
+	else
+	{
+		fp->idealGroups.push_back(all);
+		fp->idealGroups.push_back(vector<unsigned>());
+	}
+}
+
 
 //******************************************************************************************/
 //
@@ -70,6 +113,27 @@ void optimization(int argc, char* argv[])
 	unsigned int sizeOfSubcomponents;
 	unsigned int numOfIndividuals;
 	unsigned int numberOfEvaluations;
+	typeOfCycle cycleMode;
+	unsigned int numThreads;
+	unsigned int numInFlight;
+	typeOfAllocation allocationMode;
+	double contributionShare;
+	typeOfRegrouping regroupingMode;
+	unsigned int regroupingInterval;
+	typeOfDecomposition decompositionMode;
+	unsigned int groupingEvaluations;
+	string groupingCacheFile;
+	typeOfMerge mergeMode;
+	unsigned int numIslands;
+	unsigned int migrationInterval;
+	string checkpointFile;
+	unsigned int checkpointInterval;
+	bool resume;
+	unsigned int numJobs;
+	string gridFile;
+	string benchmarkName;
+	string outputPrefix;
+	vector<unsigned> candidateSizes;
     
 	vector<int> seeds;
     unsigned maxNumRep = 100;
@@ -81,7 +145,7 @@ void optimization(int argc, char* argv[])
 	{
 		CmdLine cmd("SACCJADE - Surrogate-assisted Cooperative Coevolution for Large-Scale Optimization of Computationally Expensive Objective Functions", ' ', "1.0");
 
-		ValueArg<unsigned int> functionArg("f", "function", "function to optimize [1-15]", false, 1, "int");
+		ValueArg<unsigned int> functionArg("f", "function", "function to optimize [1-15 -> CEC2013; 16 -> shifted elliptic of any dimension]", false, 1, "int");
 		cmd.add(functionArg);
 
 		ValueArg<unsigned int> surrogateArg("m", "metamodel", "type of fitness metamodel [0->none; 1->GP; 2->QPA; 3->RBFN; 4->SVR]", false, 4, "int");
@@ -93,8 +157,8 @@ void optimization(int argc, char* argv[])
 		ValueArg<unsigned int> iteArg("i", "iterations", "number of JADE iterations per cycle", false, 5, "int");
 		cmd.add(iteArg);		
 
-		//ValueArg<unsigned int> dimArg("d", "dimension", "problem dimension", false, 1000, "int");
-		//cmd.add(dimArg);		
+		ValueArg<unsigned int> dimArg("", "dimension", "problem dimension [1000 for the CEC2013 functions; any for f16]", false, 1000, "int");
+		cmd.add(dimArg);		
 
 		ValueArg<unsigned int> sdimArg("s", "subdim", "size of subcomponents", false, 5, "int");
 		cmd.add(sdimArg);		
@@ -105,16 +169,104 @@ void optimization(int argc, char* argv[])
 		ValueArg<unsigned int> feArg("e", "fevals", "allowed number of exact fitness evaluations", false, 10*1000, "int");
 		cmd.add(feArg);		
 
+		ValueArg<unsigned int> cycleArg("c", "cycle", "optimization of subcomponents within a cycle [0->sequential (Gauss-Seidel); 1->parallel (Jacobi)]", false, 0, "int");
+		cmd.add(cycleArg);
+
+		ValueArg<unsigned int> threadsArg("t", "threads", "number of worker threads in parallel mode [0->all hardware threads]", false, 0, "int");
+		cmd.add(threadsArg);
+
+		ValueArg<unsigned int> asyncArg("a", "async", "evaluations in flight in the asynchronous steady-state JADE [0->generational JADE]", false, 0, "int");
+		cmd.add(asyncArg);
+
+		ValueArg<unsigned int> allocationArg("b", "allocation", "allocation of the generations of a cycle [0->uniform; 1->contribution-based (CBCC)]", false, 0, "int");
+		cmd.add(allocationArg);
+
+		ValueArg<double> shareArg("", "contributionShare", "fraction of the generations of a cycle allocated according to the contributions, with -b 1 [0-1]", false, 0.5, "real");
+		cmd.add(shareArg);
+
+		ValueArg<unsigned int> reevaluationArg("q", "reevaluation", "parents re-evaluated after a random grouping [0->all; 1->only the best of each subcomponent; 2->none, stale fitness resolved lazily]", false, 0, "int");
+		cmd.add(reevaluationArg);
+
+		ValueArg<unsigned int> regroupArg("y", "regroupEvery", "cycles between two random groupings", false, 1, "int");
+		cmd.add(regroupArg);
+
+		ValueArg<unsigned int> decompositionArg("d", "decomposition", "decomposition [0->random grouping; 1->differential grouping (DG2); 2->differential grouping, groups larger than -s split; 3->groups of the benchmark function, groups larger than -s split]", false, 0, "int");
+		cmd.add(decompositionArg);
+
+		ValueArg<unsigned int> groupingBudgetArg("", "groupingBudget", "evaluations available to differential grouping [0->complete interaction matrix, 1+n+n(n-1)/2]", false, 0, "int");
+		cmd.add(groupingBudgetArg);
+
+		ValueArg<string> groupingCacheArg("", "groupingCache", "file keeping the evaluations of differential grouping, reused by later runs on the same function", false, "", "string");
+		cmd.add(groupingCacheArg);
+
+		ValueArg<unsigned int> mergeArg("", "merge", "merge of the collaborators into the context vector [0->sequential, one evaluation per subcomponent; 1->one batch, then greedy merge in groups]", false, 0, "int");
+		cmd.add(mergeArg);
+
+		ValueArg<unsigned int> islandsArg("k", "islands", "number of islands, each with its own decomposition, run on separate threads [1->no islands]", false, 1, "int");
+		cmd.add(islandsArg);
+
+		ValueArg<unsigned int> migrationArg("g", "migration", "cycles between two migrations of the best context vectors among the islands", false, 5, "int");
+		cmd.add(migrationArg);
+
+		ValueArg<string> checkpointArg("w", "checkpoint", "file where the state of each repetition is periodically saved (suffixed with the repetition index) [empty->no checkpoints]", false, "", "string");
+		cmd.add(checkpointArg);
+
+		ValueArg<unsigned int> checkpointIntervalArg("n", "checkpointEvery", "cycles between two checkpoints", false, 10, "int");
+		cmd.add(checkpointIntervalArg);
+
+		SwitchArg resumeArg("u", "resume", "resume each repetition from its checkpoint, if it exists", false);
+		cmd.add(resumeArg);
+
+		ValueArg<unsigned int> jobsArg("j", "jobs", "number of repetitions run concurrently, each on its own thread [0->all hardware threads]", false, 1, "int");
+		cmd.add(jobsArg);
+
+		ValueArg<string> gridArg("x", "experiment", "run the experiment grid described in the file (see ExperimentGrid.h); the other options are ignored", false, "", "string");
+		cmd.add(gridArg);
+
+		ValueArg<string> benchArg("", "bench", "run a microbenchmark (see bench/Benchmarks.h) [trial, generation, scaling]; the other options are ignored", false, "", "string");
+		cmd.add(benchArg);
+
+		ValueArg<string> outputArg("o", "output", "prefix of the output files, e.g. a directory", false, "", "string");
+		cmd.add(outputArg);
+
+		ValueArg<string> sizesArg("l", "sizes", "comma-separated sizes of subcomponents among which the size is adapted at each cycle, e.g. 5,10,25,50,100 (must include -s) [empty->fixed size]", false, "", "string");
+		cmd.add(sizesArg);
+
 		cmd.parse(argc, argv);
 		
 		functionIndex = functionArg.getValue();
 		sType = (typeOfSurrogate)surrogateArg.getValue();
 		numRep = repArg.getValue();
 		numItePerCycle = iteArg.getValue();
-		problemDimension = 1000;// dimArg.getValue();
+		problemDimension = dimArg.getValue();
 		sizeOfSubcomponents = sdimArg.getValue();
 		numOfIndividuals = npopArg.getValue();
 		numberOfEvaluations = feArg.getValue();
+		cycleMode = (typeOfCycle)cycleArg.getValue();
+		numThreads = threadsArg.getValue();
+		numInFlight = asyncArg.getValue();
+		allocationMode = (typeOfAllocation)allocationArg.getValue();
+		contributionShare = shareArg.getValue();
+		regroupingMode = (typeOfRegrouping)reevaluationArg.getValue();
+		regroupingInterval = regroupArg.getValue();
+		decompositionMode = (typeOfDecomposition)decompositionArg.getValue();
+		groupingEvaluations = groupingBudgetArg.getValue();
+		groupingCacheFile = groupingCacheArg.getValue();
+		mergeMode = (typeOfMerge)mergeArg.getValue();
+		numIslands = islandsArg.getValue();
+		migrationInterval = migrationArg.getValue();
+		checkpointFile = checkpointArg.getValue();
+		checkpointInterval = checkpointIntervalArg.getValue();
+		resume = resumeArg.getValue();
+		numJobs = jobsArg.getValue();
+		gridFile = gridArg.getValue();
+		benchmarkName = benchArg.getValue();
+		outputPrefix = outputArg.getValue();
+
+		stringstream sizes(sizesArg.getValue());
+		string size;
+		while (getline(sizes, size, ','))
+			candidateSizes.push_back(atoi(size.c_str()));
 
 	}
     catch (ArgException& e)
@@ -122,6 +274,20 @@ void optimization(int argc, char* argv[])
 	   cout << "ERROR: " << e.error() << " " << e.argId() << endl;
     }
 
+	if (!benchmarkName.empty())
+	{
+		runBenchmark(benchmarkName);
+		return;
+	}
+
+	if (!gridFile.empty())
+	{
+		ExperimentGrid grid;
+		grid.load(gridFile);
+		grid.run([](unsigned functionIndex) { return generateFuncObj(functionIndex); });
+		return;
+	}
+
 		
 	if (sType == sNone)
         cout << "Using CCJADE" << endl;
@@ -139,26 +305,111 @@ void optimization(int argc, char* argv[])
         exit(1);
     }
 
-	if ( functionIndex < 1 || functionIndex>15 )
+	if (cycleMode != cSequential && cycleMode != cParallel)
 	{
-		cerr << "function index out of allowed bounds [1..15]" << endl;
+		cerr << "unknown cycle mode" << endl;
 		exit(1);
 	}
-	
-	Fitness* f = generateFuncObj(functionIndex);
 
-	if (f == NULL)
+	if (allocationMode != aUniform && allocationMode != aContribution)
 	{
-		cerr << "Unable to create fitness function" << endl;
+		cerr << "unknown allocation mode" << endl;
+		exit(1);
+	}
+
+	if (regroupingMode != rAll && regroupingMode != rBest && regroupingMode != rStale)
+	{
+		cerr << "unknown re-evaluation mode" << endl;
+		exit(1);
+	}
+
+	if (decompositionMode != dRandom && decompositionMode != dDifferential && decompositionMode != dDifferentialCapped && decompositionMode != dIdeal)
+	{
+		cerr << "unknown decomposition" << endl;
+		exit(1);
+	}
+
+	if (mergeMode != mSequential && mergeMode != mGroups)
+	{
+		cerr << "unknown merge mode" << endl;
+		exit(1);
+	}
+
+	if (decompositionMode != dRandom && candidateSizes.size() > 1)
+	{
+		cerr << "the adaptive size of subcomponents (-l) requires random grouping" << endl;
+		exit(1);
+	}
+
+	if (regroupingInterval < 1)
+	{
+		cerr << "the cycles between two random groupings must be at least 1" << endl;
+		exit(1);
+	}
+
+	if (numInFlight > 0 && (cycleMode != cSequential || sType != sNone))
+	{
+		cerr << "the steady-state JADE requires the sequential cycle and no surrogate (-m 0)" << endl;
+		exit(1);
+	}
+
+	if (numIslands < 1 || migrationInterval < 1)
+	{
+		cerr << "at least one island and one cycle between migrations are required" << endl;
+		exit(1);
+	}
+
+	if (numIslands > 1 && (cycleMode != cSequential || numInFlight > 0))
+	{
+		cerr << "islands require the sequential cycle and the generational JADE" << endl;
+		exit(1);
+	}
+
+	if (!checkpointFile.empty() && checkpointInterval < 1)
+	{
+		cerr << "at least one cycle between two checkpoints is required" << endl;
+		exit(1);
+	}
+
+	if (resume && checkpointFile.empty())
+	{
+		cerr << "resuming requires a checkpoint file (-w)" << endl;
+		exit(1);
+	}
+
+	if (numRep < 1 || numRep > maxNumRep)
+	{
+		cerr << "number of repetitions out of allowed bounds [1.." << maxNumRep << "]" << endl;
+		exit(1);
+	}
+
+	if (numJobs == 0)
+		numJobs = max(1u, thread::hardware_concurrency());
+	numJobs = min(numJobs, numRep);
+
+	if ( functionIndex < 1 || functionIndex>16 )
+	{
+		cerr << "function index out of allowed bounds [1..16]" << endl;
+		exit(1);
+	}
+
+	if (problemDimension<1 || (functionIndex<=15 && problemDimension!=1000))
+	{
+		cerr << "problem dimension must be 1000 for the CEC2013 functions and at least 1 for f16" << endl;
 		exit(1);
 	}
 	
-	if (problemDimension<1 || problemDimension>1000)
+	Fitness* f = generateFuncObj(functionIndex, problemDimension);
+
+	if (f == NULL)
 	{
-		cerr << "problem dimension must be in [1..1000]" << endl;
+		cerr << "Unable to create fitness function" << endl;
 		exit(1);
 	}
 
+	if (decompositionMode == dIdeal)
+		createIdealGroups(f, functionIndex);
+	
 	if (sizeOfSubcomponents<1 || sizeOfSubcomponents>problemDimension)
 	{
 		cerr << "problem dimension must be in [1..problem dimension]" << endl;
@@ -168,23 +419,97 @@ void optimization(int argc, char* argv[])
     cout << "Optimizing f" << functionIndex << endl;
 	cout << "Problem dimension = " << problemDimension << endl;
     cout << "Number of iterations per cycle = " << numItePerCycle << endl;    	
-	cout << "The problem is decomposed in " << problemDimension / sizeOfSubcomponents << " equal subcomponents of size " << sizeOfSubcomponents << endl;
+	if (decompositionMode == dRandom)
+		cout << "The problem is decomposed in " << problemDimension / sizeOfSubcomponents << " equal subcomponents of size " << sizeOfSubcomponents << endl;
+	else if (decompositionMode == dIdeal)
+		cout << "The problem is decomposed according to the groups of the benchmark function, in subcomponents of size up to " << sizeOfSubcomponents << endl;
+	else
+		cout << "The problem is decomposed by differential grouping, separable variables" << (decompositionMode == dDifferentialCapped ? " and large groups" : "")
+		     << " in subcomponents of size " << sizeOfSubcomponents << endl;
+	if (mergeMode == mGroups)
+		cout << "Collaborators evaluated in one batch and merged greedily in groups" << endl;
     cout << "Number of individuals per subcomponent = " << numOfIndividuals << endl;
 	cout << "Number of repetitions = " << numRep << endl;
 	cout << "Allowed number of exact function evaluations = " << numberOfEvaluations << endl;
-
-    double time = 0;
-    vector< vector<ConvPlotPoint> > convergences;
-    for (unsigned k = 0; k < numRep; ++k)
+	if (cycleMode == cParallel)
+		cout << "Subcomponents optimized in parallel (Jacobi) with " << numThreads << " threads (0 = all)" << endl;
+	else
+		cout << "Subcomponents optimized sequentially (Gauss-Seidel)" << endl;
+	if (numInFlight > 0)
+		cout << "Steady-state JADE with " << numInFlight << " evaluations in flight on " << numThreads << " threads (0 = all)" << endl;
+	if (allocationMode == aContribution)
+		cout << "Generations of each cycle allocated according to the contribution of the subcomponents" << endl;
+	if (regroupingMode != rAll || regroupingInterval > 1)
+		cout << "Random grouping every " << regroupingInterval << " cycles, re-evaluating "
+		     << (regroupingMode == rAll ? "all the parents" : regroupingMode == rBest ? "only the best parent of each subcomponent" : "no parents (stale fitness)") << endl;
+	if (numIslands > 1)
+		cout << numIslands << " islands on " << numThreads << " threads (0 = all), migration every " << migrationInterval << " cycles" << endl;
+	if (candidateSizes.size() > 1)
+	{
+		cout << "Size of subcomponents adapted at each cycle among";
+		for (unsigned i = 0; i < candidateSizes.size(); ++i)
+			cout << " " << candidateSizes[i];
+		cout << endl;
+	}
+	if (numJobs > 1)
+		cout << numJobs << " repetitions run concurrently, each report is printed when its repetition finishes" << endl;
+	if (!checkpointFile.empty())
+		cout << "Checkpoint every " << checkpointInterval << " cycles to " << checkpointFile << "_r<repetition>" << (resume ? ", resuming from existing checkpoints" : "") << endl;
+
+    vector< vector<ConvPlotPoint> > convergences(numRep);
+    atomic<unsigned> nextRepetition(0);
+    mutex outputMutex;
+
+    //Each thread runs the next repetition not yet taken. The objective function keeps scratch
+    //buffers, so each thread has its own copy, which loads the data tables once and is reused
+    //for all the repetitions of that thread; like f, the copies live until the end of the program.
+    //The optimizers released at the end of a repetition are reused by the next one of the thread
+    auto runRepetitions = [&](Fitness *repetitionFitness)
     {
-        vector<ConvPlotPoint> convergence;
-        CCDE ccde;
-        int seed = seeds[k];
-        ccde.optimize(f, numberOfEvaluations, sizeOfSubcomponents, numOfIndividuals,
-                      convergence, seed, sType, numItePerCycle);
-        time = ccde.elapsedTime;
-        convergences.push_back(convergence);
-    }
+        JADEPool optimizerPool;
+        for (unsigned k = nextRepetition++; k < numRep; k = nextRepetition++)
+        {
+            if (repetitionFitness == NULL)
+            {
+                repetitionFitness = generateFuncObj(functionIndex, problemDimension);
+                if (decompositionMode == dIdeal)
+                    createIdealGroups(repetitionFitness, functionIndex);
+            }
+
+            ostringstream report;
+            CCDE ccde;
+            ccde.setOptimizerPool(optimizerPool);
+            if (numJobs > 1)
+                ccde.setLog(report);
+            ccde.setCycleMode(cycleMode, numThreads, [functionIndex, problemDimension]() { return generateFuncObj(functionIndex, problemDimension); });
+            if (numInFlight > 0)
+                ccde.setGenerationMode(gSteadyState, numInFlight);
+            ccde.setAllocationMode(allocationMode, contributionShare);
+            ccde.setRegroupingMode(regroupingMode, regroupingInterval);
+            ccde.setDecompositionMode(decompositionMode, groupingEvaluations, groupingCacheFile);
+            ccde.setMergeMode(mergeMode);
+            ccde.setIslandMode(numIslands, migrationInterval);
+            ccde.setSubcomponentSizes(candidateSizes);
+            if (!checkpointFile.empty())
+                ccde.setCheckpoint(checkpointFile + "_r" + to_string(k), checkpointInterval, resume);
+            int seed = seeds[k];
+            ccde.optimize(repetitionFitness, numberOfEvaluations, sizeOfSubcomponents, numOfIndividuals,
+                          convergences[k], seed, sType, numItePerCycle);
+
+            lock_guard<mutex> lock(outputMutex);
+            cout << report.str();
+            if (!convergences[k].empty())
+                cout << "Repetition " << k << " (seed " << seed << ") finished: NOE=" << convergences[k].back().nfe
+                     << "  err=" << std::scientific << convergences[k].back().f << "  wall time=" << ccde.wallTime << " s" << endl;
+        }
+    };
+
+    vector<thread> jobs;
+    for (unsigned j = 1; j < numJobs; ++j)
+        jobs.push_back(thread(runRepetitions, (Fitness*)NULL));
+    runRepetitions(f);
+    for (unsigned j = 0; j < jobs.size(); ++j)
+        jobs[j].join();
 
     char fName[256];
     FILE *file;
@@ -201,9 +526,15 @@ void optimization(int argc, char* argv[])
     else if (sType == sRBFN)
 		sprintf_s(fName, "convplot_f%d_dec%d_popsize%d_RBFN_SACCJADE.csv", functionIndex + 1, sizeOfSubcomponents, numOfIndividuals);
 	else if (sType == sSVR)
-		sprintf_s(fName, "convplot_f%d_dec%d_popsize%d_RBFN_SACCJADE.csv", functionIndex + 1, sizeOfSubcomponents, numOfIndividuals);
+		sprintf_s(fName, "convplot_f%d_dec%d_popsize%d_SVR_SACCJADE.csv", functionIndex + 1, sizeOfSubcomponents, numOfIndividuals);
 
-    fopen_s(&file, fName, "wt");
+    string convplotFileName = outputPrefix + fName;
+    fopen_s(&file, convplotFileName.c_str(), "wt");
+    if (file == NULL)
+    {
+        cerr << "unable to write " << convplotFileName << endl;
+        exit(1);
+    }
     vector<ConvPlotPoint> averageConvergence;
 
     int maxSize = 0;
@@ -232,7 +563,26 @@ void optimization(int argc, char* argv[])
     }
     fclose(file);
 
+    //generations allocated to each subcomponent, one row per cycle: repetition; cycle; NOE; generations...
+    if (allocationMode == aContribution)
+    {
+        string allocationFileName = outputPrefix + "allocation_" + fName;
+        fopen_s(&file, allocationFileName.c_str(), "wt");
+        for (unsigned k = 0; k < convergences.size(); ++k)
+            for (unsigned q = 0; q < convergences[k].size(); ++q)
+            {
+                fprintf(file, "%d; %d; %d", k, q, convergences[k][q].nfe);
+                for (unsigned j = 0; j < convergences[k][q].generations.size(); ++j)
+                    fprintf(file, "; %d", convergences[k][q].generations[j]);
+                fprintf(file, "\n");
+            }
+        fclose(file);
+    }
+
+#ifdef _WIN32
+	//keep the console open when launched from the IDE
 	system("pause");
+#endif
 }
 
 
@@ -172,29 +172,54 @@ void QuadraticRegression::setData(std::vector< std::vector<double> > &points, st
     */
 
     for (int i = 0; i<numPoints; ++i)
+        setRow(i, &points[i][0]);
+
+    fit(&values[0]);
+}
+
+
+void QuadraticRegression::setData(const double *points, const double *values)
+{
+    if (numPoints != nt)
     {
-        X[i][0] = 1.0;
+        cerr << "Error in QPA" << endl;
+        exit(1);
+    }
 
-        for (int k = 0; k<dim; ++k)
-        {
-            X[i][1 + k] = points[i][k]; //linear terms
+    for (int i = 0; i<numPoints; ++i)
+        setRow(i, points + (size_t)i*dim);
 
-            /*
-            mean[k] += points[i][k]/numPoints;
+    fit(values);
+}
 
-            if( points[i][k]>hiBound[k] )
-            hiBound[k] = points[i][k];
-            if( points[i][k]<loBound[k] )
-            loBound[k] = points[i][k];
-            */
-        }
 
-        int r = 0;
-        for (int k = 0; k<dim; ++k)
-            for (int q = k; q<dim; ++q, ++r)
-                X[i][1 + dim + r] = points[i][k] * points[i][q]; //quadratic terms
+void QuadraticRegression::setRow(int i, const double *point)
+{
+    X[i][0] = 1.0;
+
+    for (int k = 0; k<dim; ++k)
+    {
+        X[i][1 + k] = point[k]; //linear terms
+
+        /*
+        mean[k] += point[k]/numPoints;
+
+        if( point[k]>hiBound[k] )
+        hiBound[k] = point[k];
+        if( point[k]<loBound[k] )
+        loBound[k] = point[k];
+        */
     }
 
+    int r = 0;
+    for (int k = 0; k<dim; ++k)
+        for (int q = k; q<dim; ++q, ++r)
+            X[i][1 + dim + r] = point[k] * point[q]; //quadratic terms
+}
+
+
+void QuadraticRegression::fit(const double *values)
+{
     for (int i = 0; i<nt; ++i)
         for (int j = 0; j<nt; ++j)
         {
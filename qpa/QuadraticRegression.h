@@ -29,11 +29,15 @@ public:
 	QuadraticRegression(std::vector< std::vector<double> > &_points, std::vector< double > &_values);
    ~QuadraticRegression();
     void setData(std::vector< std::vector<double> > &_points, std::vector< double > &_values);
+    ///numPoints points stored one after the other, dim values each
+    void setData(const double *_points, const double *_values);
     void solve(double **Mat, double *U, int neq);
     int maxModInColumnindex(double **A, int rows, int column, int starting_column);
     double evaluate(std::vector<double> &point);
     std::vector<double> evaluateGradient(std::vector<double> &point);
 	void reset() { ready = false; };
+    void setRow(int i, const double *point);
+    void fit(const double *values);
          
     int dim;
     int nt;
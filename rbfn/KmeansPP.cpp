@@ -2,8 +2,8 @@
 
 using namespace std;
 
-KmeansPP::KmeansPP(const std::vector<datapoint> &input_data) 
-	: input_data(input_data), random_index_gen(0, input_data.size()-1), random_real_gen(0, 1), random_engine(rd())
+KmeansPP::KmeansPP(const std::vector<datapoint> &input_data, unsigned seed) 
+	: input_data(input_data), random_index_gen(0, input_data.size()-1), random_real_gen(0, 1), random_engine(seed)
 {}
 
 KmeansPP::~KmeansPP(void)
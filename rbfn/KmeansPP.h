@@ -15,7 +15,7 @@ public:
 	//typedef std::vector<double> datapoint;
 
 	/*	Takes the input data where each data point is in a vector<double> format */
-	KmeansPP(const std::vector<datapoint> &input_data);
+	KmeansPP(const std::vector<datapoint> &input_data, unsigned seed);
 	
 	~KmeansPP(void);
 
@@ -38,7 +38,6 @@ private:
 
 	// Random Number seed devices/engines/distributions
 	//mt19937 mt;
-    std::random_device rd;
 	std::default_random_engine random_engine;
 	std::uniform_int_distribution<int> random_index_gen;
 	std::uniform_real_distribution<double> random_real_gen;
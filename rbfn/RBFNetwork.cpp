@@ -3,13 +3,13 @@
 using namespace std;
 
 RBFNetwork::RBFNetwork(const vector<datapoint> &training_data, const vector<double> &training_values)
-    : training_data(training_data), training_values(training_values), random_real_gen(-1, 1), random_engine(rd())
+    : training_data(training_data), training_values(training_values), random_real_gen(-1, 1)
 {
     type = rbfntOneSigmaPerCentre;
 }
 
 RBFNetwork::RBFNetwork()
-    :  random_real_gen(-1, 1), random_engine(rd())
+    :  random_real_gen(-1, 1)
 {
     type = rbfntOneSigmaPerDir;
 }
@@ -18,7 +18,7 @@ RBFNetwork::RBFNetwork(const vector<datapoint> &training_data, const vector<doub
                        const vector<datapoint> &testing_data, const vector<double> &testing_values)
     : training_data(training_data), training_values(training_values),
       testing_data(testing_data), testing_values(testing_values),
-      random_real_gen(-1, 1), random_engine(rd())
+      random_real_gen(-1, 1)
 {
     type = rbfntOneSigmaPerCentre;
 }
@@ -29,6 +29,11 @@ RBFNetwork::~RBFNetwork(void)
 }
 
 
+void RBFNetwork::seed(unsigned s)
+{
+    random_engine.seed(s);
+}
+
 void RBFNetwork::reset()
 {
     training_data.clear();
@@ -56,7 +61,7 @@ double RBFNetwork::training(int num_rbf_units, double learning_rate, int num_ite
     }
 
     // Calculate RBF Centroids
-    KmeansPP KMPP(training_data);
+    KmeansPP KMPP(training_data, random_engine());
     rbf_centroids.clear();
     KMPP.RunKMeansPP(num_rbf_units, rbf_centroids);
 
@@ -80,7 +85,7 @@ for (auto &w : layer2_weights)
     double mse = 0, prev_testing_mse = 1.0E100;
     for (int iter = 0; iter < num_iterations; iter++)
     {
-        random_shuffle(indexes.begin(), indexes.end());
+        shuffle(indexes.begin(), indexes.end(), random_engine);
 
         for (int jj = 0; jj < training_data.size(); jj++)
         {
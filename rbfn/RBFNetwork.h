@@ -21,6 +21,9 @@ public:
 
 	void reset();
 
+	/* Seed the random numbers of the training (initial weights, order of the patterns, K-means++) */
+	void seed(unsigned s);
+
 	/* Start Training the Radial Basis Function network
 		Takes the number of RBF centroids, the learning rate, the number of iteration and a print flag as input
 		Saves the output model to be used in testing and single predictions 
@@ -55,7 +58,6 @@ private:
 	//std::vector<double>total_centroids_dist;
 
 	// Random Number seed devices/engines/distributions
-    std::random_device rd;
 	std::default_random_engine random_engine;
 	std::uniform_real_distribution<double> random_real_gen;
 